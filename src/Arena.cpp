@@ -0,0 +1,78 @@
+#include "Arena.hpp"
+#include <cassert>
+
+Arena::Arena(size_t block_size, bool huge_pages)
+	:	block_size_(block_size), allocated_(0), pages_(huge_pages)
+{}
+
+Arena::~Arena()
+{	release();
+}
+
+/***************************************************/
+/*	Getters	*/
+
+size_t Arena::getAllocated() const
+{	return allocated_;
+}
+
+size_t Arena::getBlocks() const
+{	return blocks_.size();
+}
+
+HugePageAllocator const& Arena::getPages() const
+{	return pages_;
+}
+
+size_t Arena::getResidentHugeBytes() const
+{	size_t bytes(0);
+	vector<void const*> transparent;
+	for(size_t i(0);i<blocks_.size();++i)
+	{	if(blocks_[i].pages==HugeTLBPages)
+		{	bytes+=blocks_[i].size;
+		} else if(blocks_[i].pages==TransparentHugePages)
+		{	transparent.push_back(blocks_[i].data);
+		}
+	}
+	return bytes+HugePageAllocator::getResidentHugeBytes(transparent);
+}
+
+/***************************************************/
+/*	Setters	*/
+
+void Arena::setHugePages(bool const& huge_pages)
+{	pages_.setEnabled(huge_pages);
+}
+
+/***************************************************/
+
+void* Arena::allocate(size_t const& bytes, size_t const& alignment)
+{	assert(alignment>0 && (alignment&(alignment-1))==0);
+	
+	/*	The allocation is placed after the last one of the present block, rounded up to the alignment.	*/
+	if(!blocks_.empty())
+	{	Block& block(blocks_.back());
+		size_t address(reinterpret_cast<size_t>(block.data)+block.used);
+		size_t offset(((address+alignment-1)&~(alignment-1))-reinterpret_cast<size_t>(block.data));
+		if(offset+bytes<=block.size)
+		{	block.used=offset+bytes;
+			allocated_+=bytes;
+			return block.data+offset;
+		}
+	}
+	
+	/*	Otherwise a new block is needed, large enough for the allocation and its alignment.	*/
+	size_t size(bytes+alignment>block_size_ ? bytes+alignment : block_size_);
+	Block block = { nullptr, size, 0, NormalPages };
+	block.data=static_cast<char*>(pages_.allocate(block.size, block.pages));
+	blocks_.push_back(block);
+	return allocate(bytes, alignment);
+}
+
+void Arena::release()
+{	for(size_t i(0);i<blocks_.size();++i)
+	{	pages_.deallocate(blocks_[i].data, blocks_[i].size, blocks_[i].pages);
+	}
+	blocks_.clear();
+	allocated_=0;
+}
@@ -0,0 +1,98 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <vector>
+#include <cstddef>
+#include <new>
+#include <utility>
+#include "HugePageAllocator.hpp"
+
+using namespace std;
+
+//! Arena class
+/*!	Memory arena: objects are allocated one after the other in large blocks, and all blocks are released
+ * 	at once. Nothing is freed individually, and the objects created in the arena never move, so that
+ * 	pointers on them stay valid until the arena is released.
+ * 
+ * 	The blocks are mapped by a HugePageAllocator, so that the blocks of an arena holding large arrays
+ * 	can be backed by huge pages.
+ * 
+ * 	The arena only manages memory: objects created with create() must be destroyed by their owner
+ * 	before the arena is released.	*/
+class Arena
+{
+	private:
+	
+	/*!	A block of memory and the number of bytes already allocated in it.	*/
+	struct Block
+	{	char* data;		/**<	Memory of the block.			*/
+		size_t size;	/**<	Size of the block in bytes.		*/
+		size_t used;	/**<	Bytes already allocated.		*/
+		PageKind pages;	/**<	Pages backing the block.		*/
+	};
+	
+	vector<Block> blocks_;		/**<	Blocks of the arena, the last one being the one in use.		*/
+	size_t block_size_;			/**<	Default size of a new block in bytes.						*/
+	size_t allocated_;			/**<	Total number of bytes allocated.							*/
+	HugePageAllocator pages_;	/**<	Maps the blocks.											*/
+	
+	public:
+	//! Constructor
+	/*!	@param block_size: Default size of a block in bytes. Larger allocations get their own block.
+	 * 	@param huge_pages: Whether blocks of at least 2 MB are backed by huge pages.	*/
+	explicit Arena(size_t block_size=1<<20, bool huge_pages=false);
+	
+	//! Destructor
+	/*!	Releases all blocks.	*/
+	~Arena();
+	
+	Arena(Arena const&) = delete;
+	Arena& operator=(Arena const&) = delete;
+
+/***************************************************/
+	/*	Getters	*/
+	//! Gets the number of bytes allocated in the arena
+	size_t getAllocated() const;
+	//! Gets the number of blocks of the arena
+	size_t getBlocks() const;
+	//! Gets the allocator mapping the blocks, which counts the bytes mapped with each kind of pages
+	HugePageAllocator const& getPages() const;
+	//! Gets the number of bytes of the blocks actually backed by huge pages
+	size_t getResidentHugeBytes() const;
+
+/***************************************************/
+	/*	Setters	*/
+	//! Sets whether the next blocks of at least 2 MB are backed by huge pages
+	void setHugePages(bool const& huge_pages);
+
+/***************************************************/
+	//!A public function taking two sizes as parameters
+	/*!	Allocates memory in the arena.
+	 * 	@param bytes: Number of bytes wanted.
+	 * 	@param alignment: Alignment wanted, a power of 2.
+	 * 	@return Pointer on the memory allocated.	*/
+	void* allocate(size_t const& bytes, size_t const& alignment=alignof(max_align_t));
+	
+	//!A public template function taking a number of elements as parameter
+	/*!	Allocates uninitialized memory for an array.
+	 * 	@param number: Number of elements of the array.
+	 * 	@return Pointer on the first element.	*/
+	template<typename T>
+	T* allocateArray(size_t const& number)
+	{	return static_cast<T*>(allocate(number*sizeof(T), alignof(T)));
+	}
+	
+	//!A public template function taking the arguments of a constructor as parameters
+	/*!	Constructs an object in place in the arena.
+	 * 	@return Pointer on the object.	*/
+	template<typename T, typename... Arguments>
+	T* create(Arguments&&... arguments)
+	{	return new(allocateArray<T>(1)) T(forward<Arguments>(arguments)...);
+	}
+	
+	//!A public function
+	/*!	Releases all the memory of the arena in one go.	*/
+	void release();
+};
+
+#endif
@@ -0,0 +1,186 @@
+#ifndef BRUNELENGINE_H
+#define BRUNELENGINE_H
+
+#include <vector>
+#include <cassert>
+#include <cmath>
+#include "Utility/Constants.hpp"
+#include "Utility/Precision.hpp"
+#include "SpikeComparison.hpp"
+#include "CounterRandom.hpp"
+
+using namespace std;
+
+//! BrunelAmplitudes structure
+/*!	Amplitudes of the production configuration of the Brunel network, for BrunelEngine, taken from
+ * 	Utility/Constants.hpp like in Network. A structure with the same static members can be given to the
+ * 	engine for another configuration.	*/
+struct BrunelAmplitudes
+{	static constexpr double Excitatory=ExcitatoryAmplitude;		/**<	Amplitude of the spikes of excitatory neurons, J in mV.		*/
+	static constexpr double Inhibitory=InhibitoryAmplitude;		/**<	Amplitude of the spikes of inhibitory neurons, -g*J.		*/
+	static constexpr double External=Amplitude;					/**<	Amplitude of the random spikes from outside the network.	*/
+};
+
+//! BrunelEngine class template
+/*!	Network of Network(true, true) in which the sizes, the delay, the refractory period and the amplitudes are
+ * 	compile-time constants, for the configuration simulated every day. Like in the generic network, the neurons
+ * 	have no input of their own and are driven by the random spikes.
+ *
+ * 	The state is kept as arrays rather than neurons: membrane potentials, refractory times and the ring buffers
+ * 	of all neurons slot after slot. The number of slots is rounded up to a power of 2, so that the slot of a
+ * 	time step is found with a mask, and the loops on the connections have a constant number of iterations.
+ * 	The excitatory and inhibitory neurons are delivered in two separate loops, without testing their kind.
+ *
+ * 	With the same seed, the links and the random spikes are drawn like in Network::setSeed, and the spike
+ * 	trains are the same as the ones of the generic network.
+ *
+ * 	@param Neurons: Number of neurons.
+ * 	@param Excitatory: Number of excitatory neurons, the first ones.
+ * 	@param Connections: Number of connections of each neuron.
+ * 	@param ExcitatoryConnections: Number of connections towards excitatory neurons, the first ones of a row.
+ * 	@param DelaySteps: Delay of the spikes in time steps.
+ * 	@param RefractorySteps: Refractory period in time steps.
+ * 	@param Amplitudes: Structure giving the amplitudes, like BrunelAmplitudes.	*/
+template<unsigned int Neurons, unsigned int Excitatory, unsigned int Connections, unsigned int ExcitatoryConnections,
+			unsigned int DelaySteps, unsigned int RefractorySteps, typename Amplitudes=BrunelAmplitudes>
+class BrunelEngine
+{
+	static_assert(Excitatory<=Neurons && ExcitatoryConnections<=Connections, "Inconsistent configuration");
+	static_assert(RefractorySteps>0, "The refractory period must last at least one time step");
+
+	/*!	Smallest power of 2 greater than or equal to a number.	*/
+	static constexpr unsigned int power(unsigned int number, unsigned int result=1)
+	{	return result>=number ? result : power(number, 2*result);
+	}
+
+	public:
+	static constexpr unsigned int Slots=power(DelaySteps+1);	/**<	Number of slots of the ring buffers.	*/
+	static constexpr unsigned int Mask=Slots-1;				/**<	Mask giving the slot of a time step.	*/
+
+	private:
+	unsigned int clock_time_;					/**<	Global time of the network.												*/
+	vector<Real> potentials_;					/**<	Membrane potential of each neuron.										*/
+	vector<unsigned int> refractory_;			/**<	Refractory time left of each neuron.									*/
+	vector<Accumulator> buffers_;				/**<	Ring buffers, Neurons values per slot.									*/
+	vector<unsigned int> links_;				/**<	Targets of each neuron, Connections per row.							*/
+	vector<unsigned int> spikes_;				/**<	Neurons which spiked during the present time step.						*/
+	SpikeTrains trains_;						/**<	Time steps of the spikes of each neuron.								*/
+	size_t total_spikes_;						/**<	Number of spikes since the beginning of the simulation.					*/
+
+	CounterRandom random_;						/**<	Generator of the links and of the random spikes.						*/
+	PoissonInverse noise_;						/**<	Number of random spikes received by a neuron during a time step.		*/
+
+	public:
+	//! Constructor
+	/*!	Draws the links of the network.
+	 * 	@param seed: Seed of the generator, as given to Network::setSeed.	*/
+	explicit BrunelEngine(unsigned int seed)
+		:	clock_time_(0), potentials_(Neurons, 0.0), refractory_(Neurons, 0), buffers_(Slots*Neurons, 0.0),
+			links_(Neurons*Connections), trains_(Neurons), total_spikes_(0), random_(seed),
+			noise_(ExternalFrequency*dt)
+	{
+		/*	Same draws as Network::initializeConnections.	*/
+		for(unsigned int i(0);i<Neurons;++i)
+		{	for(unsigned int j(0);j<Connections;++j)
+			{	if(j<ExcitatoryConnections)
+				{	links_[i*Connections+j]=random_.uniform(ConnectivityStream, i, j, 0, Excitatory);
+				} else {
+					links_[i*Connections+j]=random_.uniform(ConnectivityStream, i, j, Excitatory, Neurons);
+				}
+			}
+		}
+	}
+
+/***************************************************/
+	/*	Getters	*/
+	//! Gets the clock time
+	unsigned int getClockTime() const { return clock_time_; }
+	//! Gets the membrane potential of a neuron
+	double getMembranePotential(unsigned int const& neuron) const { return potentials_[neuron]; }
+	//! Gets the refractory time left of a neuron
+	unsigned int getRefractoryTime(unsigned int const& neuron) const { return refractory_[neuron]; }
+	//! Gets the targets of a neuron
+	View<unsigned int const> getLinkRow(unsigned int const& neuron) const
+	{	return View<unsigned int const>(links_.data()+neuron*Connections, Connections);
+	}
+	//! Gets the spike trains of the neurons
+	SpikeTrains const& getTrains() const { return trains_; }
+	//! Gets the number of spikes since the beginning of the simulation
+	size_t getTotalSpikes() const { return total_spikes_; }
+
+/***************************************************/
+	//!A public function taking a double as parameter
+	/*!	Simulates the network until a time.
+	 * 	@param endtime: Time at which the simulation will end.	*/
+	void update(double const& endtime)
+	{	unsigned int end(endtime/dt);
+		Real const c(C), threshold(MembraneThreshold), reset(MembraneReset), external(Amplitudes::External);
+
+		while(clock_time_<end)
+		{	Accumulator* read(&buffers_[(clock_time_&Mask)*Neurons]);
+			spikes_.clear();
+
+			/*	Same update as Neuron::update, with the random spikes of the neuron at this time step.	*/
+			for(unsigned int i(0);i<Neurons;++i)
+			{	if(refractory_[i]>0)
+				{	potentials_[i]=reset;
+					--refractory_[i];
+				} else {
+					unsigned int random(noise_(random_.uniform(NoiseStream, i, clock_time_)));
+					if(potentials_[i]>threshold)
+					{	spikes_.push_back(i);
+						refractory_[i]=RefractorySteps-1;
+					} else {
+						potentials_[i]=potentials_[i]*c+Real(read[i]+random*external);
+					}
+				}
+				read[i]=0.0;
+			}
+
+			/*	The spikes are delivered in the order of the neurons, the excitatory ones first.	*/
+			Accumulator* write(&buffers_[((clock_time_+DelaySteps)&Mask)*Neurons]);
+			size_t k(0);
+			for(;k<spikes_.size() && spikes_[k]<Excitatory;++k)
+			{	deliver(spikes_[k], Accumulator(Amplitudes::Excitatory), write);
+			}
+			for(;k<spikes_.size();++k)
+			{	deliver(spikes_[k], Accumulator(Amplitudes::Inhibitory), write);
+			}
+
+			++clock_time_;
+		}
+	}
+
+	private:
+	//!A private function taking a neuron, an amplitude and a slot as parameters
+	/*!	Delivers the spike of a neuron to all its targets.
+	 * 	@param neuron: Neuron which spiked.
+	 * 	@param amplitude: Amplitude of its spikes.
+	 * 	@param write: Slot of the ring buffers in which the spikes arrive.	*/
+	void deliver(unsigned int const& neuron, Accumulator const& amplitude, Accumulator* write)
+	{	trains_[neuron].push_back(clock_time_);
+		++total_spikes_;
+		unsigned int const* row(&links_[neuron*Connections]);
+		for(unsigned int j(0);j<Connections;++j)
+		{	write[row[j]]+=amplitude;
+		}
+	}
+};
+
+template<unsigned int Neurons, unsigned int Excitatory, unsigned int Connections, unsigned int ExcitatoryConnections,
+			unsigned int DelaySteps, unsigned int RefractorySteps, typename Amplitudes>
+constexpr unsigned int BrunelEngine<Neurons, Excitatory, Connections, ExcitatoryConnections, DelaySteps, RefractorySteps, Amplitudes>::Slots;
+
+template<unsigned int Neurons, unsigned int Excitatory, unsigned int Connections, unsigned int ExcitatoryConnections,
+			unsigned int DelaySteps, unsigned int RefractorySteps, typename Amplitudes>
+constexpr unsigned int BrunelEngine<Neurons, Excitatory, Connections, ExcitatoryConnections, DelaySteps, RefractorySteps, Amplitudes>::Mask;
+
+/*	The refractory period of Utility/Constants.hpp is already counted in time steps.	*/
+static_assert(RefractoryPeriod==static_cast<unsigned int>(RefractoryPeriod), "The refractory period must be a number of time steps");
+static_assert(BrunelAmplitudes::Inhibitory==-g*BrunelAmplitudes::Excitatory, "The inhibitory amplitude must be -g*J");
+
+//! Engine of the production configuration: 12500 neurons, 1250 connections, 1.5 ms of delay, 2 ms refractory.
+typedef BrunelEngine<TotalNeurons, NumberExcitatoryNeurons, TotalConnections, NumberExcitatoryConnections, delay_steps,
+						static_cast<unsigned int>(RefractoryPeriod)> DefaultBrunelEngine;
+
+#endif
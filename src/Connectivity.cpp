@@ -0,0 +1,140 @@
+#include "Connectivity.hpp"
+#include <cassert>
+#include <algorithm>
+
+Connectivity::Connectivity(bool huge_pages)
+	:	arena_(HugePageAllocator::HugePageSize, huge_pages), min_delay_(delay_steps), max_delay_(delay_steps),
+		delay_offsets_(nullptr), delay_capacity_(0)
+{	/*	The matrix of links between neurons has a size of 12500 by 1250, since every neuron is required
+	 * 	to have 1250 connections. It is stored row after row.	*/
+	links_=arena_.allocateArray<unsigned int>(TotalNeurons*TotalConnections);
+}
+
+Connectivity::Connectivity(Connectivity const& other)
+	:	arena_(HugePageAllocator::HugePageSize, other.arena_.getPages().getEnabled()), min_delay_(other.min_delay_), max_delay_(other.max_delay_),
+		delay_offsets_(nullptr), delay_capacity_(0)
+{	links_=arena_.allocateArray<unsigned int>(TotalNeurons*TotalConnections);
+	copy(other.links_, other.links_+TotalNeurons*TotalConnections, links_);
+	if(other.delay_offsets_!=nullptr)
+	{	delay_capacity_=max_delay_-min_delay_+2;
+		size_t number(TotalNeurons*delay_capacity_);
+		delay_offsets_=arena_.allocateArray<unsigned int>(number);
+		copy(other.delay_offsets_, other.delay_offsets_+number, delay_offsets_);
+	}
+}
+
+/***************************************************/
+/*	Getters	*/
+
+matrix Connectivity::getLinks() const
+{	return matrix(links_, TotalNeurons, TotalConnections);
+}
+
+View<unsigned int const> Connectivity::getLinkRow(unsigned int const& neuron) const
+{	return View<unsigned int const>(links_+static_cast<size_t>(neuron)*TotalConnections, TotalConnections);
+}
+
+View<unsigned int const> Connectivity::getTargets(unsigned int const& neuron, unsigned int const& delay) const
+{	/*	Without delays drawn, all the targets have the same delay.	*/
+	if(delay_offsets_==nullptr)
+	{	return delay==min_delay_ ? getLinkRow(neuron) : View<unsigned int const>(nullptr, 0);
+	}
+	if(delay<min_delay_ || delay>max_delay_)
+	{	return View<unsigned int const>(nullptr, 0);
+	}
+	unsigned int const* offsets(delay_offsets_+static_cast<size_t>(neuron)*(max_delay_-min_delay_+2)+delay-min_delay_);
+	return View<unsigned int const>(links_+static_cast<size_t>(neuron)*TotalConnections+offsets[0], offsets[1]-offsets[0]);
+}
+
+unsigned int Connectivity::getMinDelay() const
+{	return min_delay_;
+}
+
+unsigned int Connectivity::getMaxDelay() const
+{	return max_delay_;
+}
+
+Arena const& Connectivity::getArena() const
+{	return arena_;
+}
+
+/***************************************************/
+
+void Connectivity::initializeConnections(CounterRandom const& random)
+{	drawLinks(random);
+
+	/*	The delays are drawn again with the links.	*/
+	if(delay_offsets_!=nullptr)
+	{	initializeDelays(random);
+	}
+}
+
+void Connectivity::setDelays(CounterRandom const& random, unsigned int const& min, unsigned int const& max)
+{	assert(min>0 && min<=max);
+	
+	/*	Rows sorted by previous delays are put back in the order of the draws of the links.	*/
+	if(delay_offsets_!=nullptr)
+	{	drawLinks(random);
+	}
+	min_delay_=min;
+	max_delay_=max;
+
+	/*	The offsets of a previous call are reused if they have room for the new delays. Otherwise they stay
+	 * 	in the arena until it is destroyed.	*/
+	if(max_delay_-min_delay_+2>delay_capacity_)
+	{	delay_capacity_=max_delay_-min_delay_+2;
+		delay_offsets_=arena_.allocateArray<unsigned int>(TotalNeurons*delay_capacity_);
+	}
+	initializeDelays(random);
+}
+
+void Connectivity::drawLinks(CounterRandom const& random)
+{
+	/*	Iteration in all neurons, since each of them need to be connected to other neurons.	*/
+	for(size_t i(0);i<TotalNeurons;++i)
+	{
+
+		/*	Each neuron receives an input of 10% from all other neurons, from which 1000 connections
+		 * 	are excitatory and 250 are inhibitory.	*/
+		for(size_t j(0);j<TotalConnections;++j)
+		{
+			/*	The random integer of the connection j of the neuron i is chosen.	*/
+			if(j<NumberExcitatoryConnections)
+			{
+				/*	The link can be any excitatory neuron. */
+				links_[i*TotalConnections+j]=random.uniform(ConnectivityStream, i, j, 0, NumberExcitatoryNeurons);
+			}else{
+
+				/*	The link can be any inhibitory neuron.	*/
+				links_[i*TotalConnections+j]=random.uniform(ConnectivityStream, i, j, NumberExcitatoryNeurons, TotalNeurons);
+			}
+		}
+	}
+}
+
+void Connectivity::initializeDelays(CounterRandom const& random)
+{	size_t buckets(max_delay_-min_delay_+1);
+	vector<unsigned int> delays(TotalConnections), row(TotalConnections);
+
+	for(size_t i(0);i<TotalNeurons;++i)
+	{	unsigned int* links(links_+i*TotalConnections);
+		unsigned int* offsets(delay_offsets_+i*(buckets+1));
+
+		/*	The delay of each synapse is drawn, and the links counted by delay.	*/
+		fill(offsets, offsets+buckets+1, 0);
+		for(size_t j(0);j<TotalConnections;++j)
+		{	delays[j]=random.uniform(DelayStream, i, j, 0, buckets);
+			++offsets[delays[j]+1];
+		}
+		for(size_t d(0);d<buckets;++d)
+		{	offsets[d+1]+=offsets[d];
+		}
+
+		/*	The links are sorted by delay, keeping their order within a delay.	*/
+		copy(links, links+TotalConnections, row.begin());
+		vector<unsigned int> next(offsets, offsets+buckets);
+		for(size_t j(0);j<TotalConnections;++j)
+		{	links[next[delays[j]]++]=row[j];
+		}
+	}
+}
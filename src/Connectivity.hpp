@@ -0,0 +1,82 @@
+#ifndef CONNECTIVITY_H
+#define CONNECTIVITY_H
+
+#include <math.h>
+#include "Arena.hpp"
+#include "CounterRandom.hpp"
+#include "Utility/Constants.hpp"
+#include "Utility/View.hpp"
+
+using namespace std;
+
+typedef MatrixView<unsigned int const> matrix; /**<	Useful typedef for better comprehension of further code.	*/
+
+//! Connectivity class
+/*!	Links of a network of all 12500 neurons and delays of its synapses, in an arena of their own.
+ *
+ * 	The connectivity does not change while the network is simulated, so networks forked from the same
+ * 	network share it. A network which modifies a shared connectivity first makes its own copy of it.	*/
+class Connectivity
+{
+	private:
+	Arena arena_;					/**<	Arena owning the links and the offsets of the delays, in blocks of 2 MB.				*/
+	unsigned int* links_;			/**<	Matrix of links between neurons, TotalConnections per row.								*/
+	unsigned int min_delay_;		/**<	Shortest delay of the synapses, in time steps.											*/
+	unsigned int max_delay_;		/**<	Longest delay of the synapses, in time steps.											*/
+	unsigned int* delay_offsets_;	/**<	First link of each delay in the rows, max_delay_-min_delay_+2 per row, nullptr if all
+											the synapses have the delay delay_steps.												*/
+	size_t delay_capacity_;			/**<	Number of offsets per row the array delay_offsets_ has room for.						*/
+
+	public:
+	//! Constructor
+	/*!	Allocates the links, which are drawn by initializeConnections.
+	 * 	@param huge_pages: Whether the links are backed by huge pages.	*/
+	explicit Connectivity(bool huge_pages=true);
+
+	//! Copy constructor
+	/*!	Copies the links and the delays, for a network modifying a shared connectivity.	*/
+	Connectivity(Connectivity const& other);
+
+	Connectivity& operator=(Connectivity const&) = delete;
+
+/***************************************************/
+	/*	Getters	*/
+	//! Gets the matrix of links
+	matrix getLinks() const;
+	//! Gets the neurons receiving the spikes of a neuron
+	View<unsigned int const> getLinkRow(unsigned int const& neuron) const;
+	//! Gets the neurons receiving the spikes of a neuron with a delay
+	View<unsigned int const> getTargets(unsigned int const& neuron, unsigned int const& delay) const;
+	//! Gets the shortest delay of the synapses
+	unsigned int getMinDelay() const;
+	//! Gets the longest delay of the synapses
+	unsigned int getMaxDelay() const;
+	//! Gets the arena owning the links, with the pages backing them
+	Arena const& getArena() const;
+
+/***************************************************/
+	//!A public function taking a generator as parameter
+	/*! Draws the links, and the delays again if they have been drawn.
+	 * 	@param random: Generator of the network.	*/
+	void initializeConnections(CounterRandom const& random);
+
+	//!A public function taking a generator and two unsigned int as parameters
+	/*!	Draws the delay of each synapse uniformly between min and max, and sorts the rows of links by delay.
+	 * 	The links are drawn again first if delays have already been drawn, so that the delays only depend on
+	 * 	the generator and not on the previous calls.
+	 * 	@param random: Generator of the network.
+	 * 	@param min: Shortest delay in time steps, at least 1.
+	 * 	@param max: Longest delay in time steps.	*/
+	void setDelays(CounterRandom const& random, unsigned int const& min, unsigned int const& max);
+
+	private:
+	//!A private function taking a generator as parameter
+	/*!	Draws the links of each neuron, excitatory ones first, in the order of their draws.	*/
+	void drawLinks(CounterRandom const& random);
+
+	//!A private function taking a generator as parameter
+	/*!	Draws the delays of the synapses between min_delay_ and max_delay_, and sorts the rows of links by delay.	*/
+	void initializeDelays(CounterRandom const& random);
+};
+
+#endif
@@ -0,0 +1,39 @@
+#include "CounterRandom.hpp"
+#include <cassert>
+#include <cmath>
+
+CounterRandom::CounterRandom(uint32_t seed)
+	:	seed_(seed)
+{}
+
+/***************************************************/
+
+unsigned int CounterRandom::uniform(RandomStream const& stream, uint32_t const& index, uint32_t const& counter,
+									unsigned int const& min, unsigned int const& max) const
+{	assert(min<max);
+
+	/*	The 32 bits of a word are scaled to the range with a product, the bias being at most (max-min)/2^32.	*/
+	Block bits(block(stream, index, counter));
+	return min+static_cast<unsigned int>((static_cast<uint64_t>(bits[0])*(max-min))>>32);
+}
+
+/***************************************************/
+
+PoissonInverse::PoissonInverse(double mean)
+	:	mean_(mean)
+{	assert(mean>=0.0 && mean<700.0);
+
+	/*	The probabilities are added beyond the mean until they are negligible compared to the resolution
+	 * 	of the uniform numbers. The last number drawn is the one of the whole tail.	*/
+	double probability(exp(-mean)), total(probability);
+	cdf_.push_back(total);
+	for(unsigned int k(1);k<=mean || probability>1e-17;++k)
+	{	probability*=mean/k;
+		total+=probability;
+		cdf_.push_back(total);
+	}
+}
+
+double PoissonInverse::getMean() const
+{	return mean_;
+}
@@ -0,0 +1,187 @@
+#ifndef COUNTERRANDOM_H
+#define COUNTERRANDOM_H
+
+#include <array>
+#include <vector>
+#include <cstdint>
+#include <math.h>
+
+using namespace std;
+
+//! RandomStream enumeration
+/*!	Purpose of the random numbers drawn, so that the numbers of different purposes are independent.	*/
+enum RandomStream
+{	ConnectivityStream,	/**<	Targets of the links of the network.				*/
+	DelayStream,		/**<	Delays of the synapses.								*/
+	NoiseStream,		/**<	Random spikes or currents received by the neurons.	*/
+	InitialStream,		/**<	Initial state of the neurons.						*/
+	ExternalLinkStream,	/**<	Links of the external population.					*/
+	ExternalSpikeStream,	/**<	Spikes of the generators of the external population.	*/
+	StimulusStream		/**<	Noise of the stimuli.								*/
+};
+
+//! CounterRandom class
+/*!	Counter-based random generator, Philox4x32-10: the random bits of a purpose, an index (a neuron) and a
+ * 	counter (a time step, a connection) are a function of the seed and of the triple only. Nothing is kept
+ * 	between two draws, so the numbers can be drawn in any order, by any thread or process, and the draws of
+ * 	any time step can be replayed without going through the previous ones.	*/
+class CounterRandom
+{
+	private:
+	uint32_t seed_;		/**<	Key of the generator.	*/
+
+	public:
+	typedef array<uint32_t, 4> Block;	/**<	Random bits of one evaluation of the generator.	*/
+
+	//! Constructor
+	/*!	@param seed: Seed chosen by the user.	*/
+	explicit CounterRandom(uint32_t seed=0);
+
+/***************************************************/
+	/*	Getters and setters	*/
+	//! Gets the seed
+	uint32_t getSeed() const { return seed_; }
+	//! Sets the seed
+	void setSeed(uint32_t const& seed) { seed_=seed; }
+
+/***************************************************/
+	//!A public function taking a purpose and two counters as parameters
+	/*!	@param stream: Purpose of the numbers.
+	 * 	@param index: Index of the object they are drawn for, for instance a neuron.
+	 * 	@param counter: Counter of the draws of this object, for instance a time step.
+	 * 	@return Block: 128 random bits.	*/
+	Block block(RandomStream const& stream, uint32_t const& index, uint32_t const& counter) const
+	{	Block words = {{index, counter, static_cast<uint32_t>(stream), 0}};
+		array<uint32_t, 2> key = {{seed_, 0}};
+		return philox(words, key);
+	}
+
+	//!A public function taking a purpose and two counters as parameters
+	/*!	@return double: Uniform number in [0, 1[, with 53 random bits.	*/
+	double uniform(RandomStream const& stream, uint32_t const& index, uint32_t const& counter) const
+	{	Block bits(block(stream, index, counter));
+		uint64_t word((static_cast<uint64_t>(bits[0])<<32) | bits[1]);
+		return (word>>11)*(1.0/9007199254740992.0);
+	}
+
+	//!A public function taking a purpose and two counters as parameters
+	/*!	Box-Muller transform of two uniform numbers of 64 bits each, taken from the same block.
+	 * 	@return double: Gaussian number of mean 0 and standard deviation 1.	*/
+	double gaussian(RandomStream const& stream, uint32_t const& index, uint32_t const& counter) const
+	{	Block bits(block(stream, index, counter));
+		uint64_t first((static_cast<uint64_t>(bits[0])<<32) | bits[1]), second((static_cast<uint64_t>(bits[2])<<32) | bits[3]);
+		double radius(sqrt(-2.0*log(((first>>11)+0.5)*(1.0/9007199254740992.0))));
+		return radius*cos(2.0*M_PI*(second>>11)*(1.0/9007199254740992.0));
+	}
+
+	//!A public template function taking a purpose, two counters and several seeds as parameters
+	/*!	Draws the numbers of uniform() for Lanes generators at once. The rounds of Philox are computed lane
+	 * 	after lane with a constant number of lanes, so that they are vectorized by the compiler.
+	 * 	@param seeds: Seeds of the generators, Lanes of them.
+	 * 	@param numbers: Receives the uniform number of each generator, Lanes of them.	*/
+	template<size_t Lanes>
+	static void uniformLanes(	RandomStream const& stream, uint32_t const& index, uint32_t const& counter,
+								uint32_t const* seeds, double* numbers)
+	{	uint32_t words[4][Lanes], key[Lanes];
+		for(size_t l(0);l<Lanes;++l)
+		{	words[0][l]=index;
+			words[1][l]=counter;
+			words[2][l]=static_cast<uint32_t>(stream);
+			words[3][l]=0;
+			key[l]=seeds[l];
+		}
+		
+		/*	Same rounds as philox(), the second word of the key being the same in all lanes.	*/
+		uint32_t second_key(0);
+		for(unsigned int round(0);round<10;++round)
+		{	for(size_t l(0);l<Lanes;++l)
+			{	uint64_t first(static_cast<uint64_t>(0xD2511F53u)*words[0][l]);
+				uint64_t second(static_cast<uint64_t>(0xCD9E8D57u)*words[2][l]);
+				words[0][l]=static_cast<uint32_t>(second>>32)^words[1][l]^key[l];
+				words[2][l]=static_cast<uint32_t>(first>>32)^words[3][l]^second_key;
+				words[1][l]=static_cast<uint32_t>(second);
+				words[3][l]=static_cast<uint32_t>(first);
+				key[l]+=0x9E3779B9u;
+			}
+			second_key+=0xBB67AE85u;
+		}
+		for(size_t l(0);l<Lanes;++l)
+		{	uint64_t word((static_cast<uint64_t>(words[0][l])<<32) | words[1][l]);
+			numbers[l]=(word>>11)*(1.0/9007199254740992.0);
+		}
+	}
+
+	//!A public function taking a purpose, two counters and two bounds as parameters
+	/*!	@param min: Smallest number drawn.
+	 * 	@param max: Number after the largest one drawn.
+	 * 	@return unsigned int: Uniform integer in [min, max[.	*/
+	unsigned int uniform(RandomStream const& stream, uint32_t const& index, uint32_t const& counter,
+							unsigned int const& min, unsigned int const& max) const;
+
+	//!A public function taking four words and a key as parameters
+	/*!	@param counter: Counter of Philox4x32.
+	 * 	@param key: Key of Philox4x32.
+	 * 	@return Block: Counter encrypted by the 10 rounds of Philox4x32.	*/
+	static Block philox(Block counter, array<uint32_t, 2> key)
+	{	for(unsigned int round(0);round<10;++round)
+		{	uint64_t first(static_cast<uint64_t>(0xD2511F53u)*counter[0]);
+			uint64_t second(static_cast<uint64_t>(0xCD9E8D57u)*counter[2]);
+			Block next = {{	static_cast<uint32_t>(second>>32)^counter[1]^key[0], static_cast<uint32_t>(second),
+							static_cast<uint32_t>(first>>32)^counter[3]^key[1], static_cast<uint32_t>(first)	}};
+			counter=next;
+			key[0]+=0x9E3779B9u;
+			key[1]+=0xBB67AE85u;
+		}
+		return counter;
+	}
+};
+
+//! PoissonInverse class
+/*!	Draws Poisson numbers of a fixed mean from a uniform number, by inversion of the tabulated cumulative
+ * 	distribution: one uniform number per draw, whatever the number drawn.	*/
+class PoissonInverse
+{
+	private:
+	double mean_;			/**<	Mean of the distribution.											*/
+	vector<double> cdf_;	/**<	Probability of each number or less, up to a negligible tail.		*/
+
+	public:
+	//! Constructor
+	/*!	@param mean: Mean of the distribution, below 700 so that its first probability is not zero.	*/
+	explicit PoissonInverse(double mean);
+
+	//!	Gets the mean of the distribution
+	double getMean() const;
+
+	//!A public function taking a double as parameter
+	/*!	@param u: Uniform number in [0, 1[.
+	 * 	@return unsigned int: Poisson number.	*/
+	unsigned int operator()(double const& u) const
+	{	unsigned int k(0);
+		while(k+1<cdf_.size() && u>=cdf_[k])
+		{	++k;
+		}
+		return k;
+	}
+
+	//!A public template function taking uniform numbers as parameters
+	/*!	Draws the numbers of operator() for Lanes uniform numbers at once, without any branch in the lanes:
+	 * 	the probabilities are compared to all the numbers until the largest one is reached.
+	 * 	@param u: Uniform numbers in [0, 1[, Lanes of them.
+	 * 	@param numbers: Receives the Poisson numbers, Lanes of them.	*/
+	template<size_t Lanes>
+	void lanes(double const* u, unsigned int* numbers) const
+	{	double largest(u[0]);
+		for(size_t l(0);l<Lanes;++l)
+		{	numbers[l]=0;
+			largest=(u[l]>largest ? u[l] : largest);
+		}
+		for(size_t k(0);k+1<cdf_.size() && largest>=cdf_[k];++k)
+		{	for(size_t l(0);l<Lanes;++l)
+			{	numbers[l]+=(u[l]>=cdf_[k]);
+			}
+		}
+	}
+};
+
+#endif
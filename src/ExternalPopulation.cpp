@@ -0,0 +1,68 @@
+#include "ExternalPopulation.hpp"
+#include <cassert>
+#include <limits>
+#include <algorithm>
+
+ExternalPopulation::ExternalPopulation(unsigned int neurons, unsigned int generators, unsigned int seed, unsigned int connections)
+	:	SpikeSource(Projection(neurons, generators, connections, CounterRandom(seed)), Amplitude),
+		probability_(ExternalFrequency*dt/connections), random_(seed), counts_(generators, 0), time_(0), total_spikes_(0)
+{	assert(generators>0 && connections>0 && probability_<1.0);
+	reset(0);
+}
+
+/***************************************************/
+/*	Getters	*/
+
+unsigned int ExternalPopulation::getGenerators() const
+{	return projection_.getSources();
+}
+
+double ExternalPopulation::getProbability() const
+{	return probability_;
+}
+
+size_t ExternalPopulation::getTotalSpikes() const
+{	return total_spikes_;
+}
+
+/***************************************************/
+
+void ExternalPopulation::reset(unsigned int const& time)
+{	next_=priority_queue<Event, vector<Event>, greater<Event>>();
+	fill(counts_.begin(), counts_.end(), 0);
+	time_=time;
+	total_spikes_=0;
+	
+	for(unsigned int k(0);k<getGenerators();++k)
+	{	schedule(k, time);
+	}
+}
+
+View<unsigned int const> ExternalPopulation::fire(unsigned int const& time)
+{	assert(time>=time_);
+	time_=time;
+	spikes_.clear();
+	
+	/*	The spikes of steps skipped since the last call are dropped.	*/
+	while(!next_.empty() && next_.top().first<=time)
+	{	Event event(next_.top());
+		next_.pop();
+		if(event.first==time)
+		{	spikes_.push_back(event.second);
+			++total_spikes_;
+		}
+		schedule(event.second, event.first+1);
+	}
+	return View<unsigned int const>(spikes_.data(), spikes_.size());
+}
+
+void ExternalPopulation::schedule(unsigned int const& generator, unsigned int const& time)
+{	
+	/*	Number of steps without spike of a Bernoulli process of probability p, by inversion.	*/
+	double u(random_.uniform(ExternalSpikeStream, generator, counts_[generator]++));
+	double interval(floor(log1p(-u)/log1p(-probability_)));
+	if(time+interval>=numeric_limits<unsigned int>::max())
+	{	return;
+	}
+	next_.push(Event(time+static_cast<unsigned int>(interval), generator));
+}
@@ -0,0 +1,79 @@
+#ifndef EXTERNALPOPULATION_H
+#define EXTERNALPOPULATION_H
+
+#include <math.h>
+#include <vector>
+#include <queue>
+#include <utility>
+#include <functional>
+#include "SpikeSource.hpp"
+#include "CounterRandom.hpp"
+#include "Utility/Constants.hpp"
+
+using namespace std;
+
+//! ExternalPopulation class
+/*!	Finite population of Poisson generators driving the neurons of a network, instead of the independent
+ * 	random spikes of each neuron. Each neuron receives connections from generators drawn at random, so two
+ * 	neurons share about connections*connections/generators generators and their inputs are correlated.
+ *
+ * 	A spike of a generator is drawn once and delivered to all its targets through the projection. The
+ * 	intervals between the spikes of a generator are geometric, and the generators are kept in a queue
+ * 	ordered by their next spike, so a time step only costs its external spikes.
+ *
+ * 	The links and the spikes are drawn by a counter-based generator, so a population with the same seed
+ * 	gives the same spikes whatever the order in which the steps are simulated after reset.	*/
+class ExternalPopulation : public SpikeSource
+{
+	private:
+	typedef pair<unsigned int, unsigned int> Event;	/**<	Time step of the next spike of a generator, and the generator.	*/
+
+	double probability_;			/**<	Probability that a generator spikes during a time step.						*/
+	CounterRandom random_;			/**<	Generator of the links and of the spikes.									*/
+	vector<unsigned int> counts_;	/**<	Number of spikes drawn for each generator since reset.						*/
+	priority_queue<Event, vector<Event>, greater<Event>> next_;	/**<	Next spike of each generator, earliest first.	*/
+	unsigned int time_;				/**<	Last time step fired.														*/
+	vector<unsigned int> spikes_;	/**<	Generators which spiked during the last time step fired.					*/
+	size_t total_spikes_;			/**<	Number of spikes fired since reset.											*/
+
+	public:
+	//! Constructor
+	/*!	Draws the links of the population, whose generators fire at the frequency which gives the neurons
+	 * 	the mean input of the random spikes.
+	 * 	@param neurons: Number of neurons driven.
+	 * 	@param generators: Number of Poisson generators.
+	 * 	@param seed: Seed of the links and of the spikes.
+	 * 	@param connections: Number of generators connected to each neuron, with repetitions.	*/
+	ExternalPopulation(unsigned int neurons, unsigned int generators, unsigned int seed,
+						unsigned int connections=NumberExternalConnections);
+
+/***************************************************/
+	/*	Getters	*/
+	//! Gets the number of generators
+	unsigned int getGenerators() const;
+	//! Gets the probability that a generator spikes during a time step
+	double getProbability() const;
+	//! Gets the number of spikes fired since reset
+	size_t getTotalSpikes() const;
+
+/***************************************************/
+	//!A public function taking a time step as parameter
+	/*!	Draws the first spike of each generator after a time step, forgetting the spikes drawn before.
+	 * 	@param time: Time step from which the population fires.	*/
+	void reset(unsigned int const& time) override;
+
+	//!A public function taking a time step as parameter
+	/*!	The spikes of the time steps skipped since the last call are lost.
+	 * 	@param time: Time step, at least the one of the last call.
+	 * 	@return View on the generators spiking during this time step, valid until the next call.	*/
+	View<unsigned int const> fire(unsigned int const& time) override;
+
+	private:
+	//!A private function taking a generator and a time step as parameters
+	/*!	Draws the next spike of a generator from a geometric interval, and queues it.
+	 * 	@param generator: Index of the generator.
+	 * 	@param time: First time step at which the spike may occur.	*/
+	void schedule(unsigned int const& generator, unsigned int const& time);
+};
+
+#endif
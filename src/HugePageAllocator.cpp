@@ -0,0 +1,136 @@
+#include "HugePageAllocator.hpp"
+#include <cassert>
+#include <new>
+#include <fstream>
+#include <sstream>
+#include <sys/mman.h>
+#include <unistd.h>
+
+const size_t HugePageAllocator::HugePageSize;
+
+HugePageAllocator::HugePageAllocator(bool enabled)
+	:	enabled_(enabled), bytes_{0, 0, 0}
+{}
+
+/***************************************************/
+/*	Getters	*/
+
+bool HugePageAllocator::getEnabled() const
+{	return enabled_;
+}
+
+size_t HugePageAllocator::getBytes(PageKind const& kind) const
+{	return bytes_[kind];
+}
+
+/***************************************************/
+/*	Setters	*/
+
+void HugePageAllocator::setEnabled(bool const& enabled)
+{	enabled_=enabled;
+}
+
+/***************************************************/
+
+void* HugePageAllocator::allocate(size_t& bytes, PageKind& kind)
+{
+	void* data(MAP_FAILED);
+
+	if(enabled_ && bytes>=HugePageSize)
+	{	bytes=(bytes+HugePageSize-1)/HugePageSize*HugePageSize;
+
+		/*	The reserved huge pages are used first, if the system has some.	*/
+#ifdef MAP_HUGETLB
+		data=mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+		if(data!=MAP_FAILED)
+		{	kind=HugeTLBPages;
+			bytes_[kind]+=bytes;
+			return data;
+		}
+#endif
+
+		/*	Otherwise a larger mapping is trimmed to a 2 MB boundary, since the kernel only uses transparent
+		 * 	huge pages for aligned ranges.	*/
+		data=mmap(nullptr, bytes+HugePageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if(data==MAP_FAILED)
+		{	throw bad_alloc();
+		}
+		char* start(static_cast<char*>(data));
+		char* aligned(reinterpret_cast<char*>((reinterpret_cast<size_t>(start)+HugePageSize-1)&~(HugePageSize-1)));
+		if(aligned>start)
+		{	munmap(start, aligned-start);
+		}
+		munmap(aligned+bytes, start+HugePageSize-aligned);
+		data=aligned;
+
+		kind=NormalPages;
+#ifdef MADV_HUGEPAGE
+		if(madvise(data, bytes, MADV_HUGEPAGE)==0)
+		{	kind=TransparentHugePages;
+		}
+#endif
+		bytes_[kind]+=bytes;
+		return data;
+	}
+
+	/*	Small arrays are mapped with normal pages.	*/
+	size_t page(sysconf(_SC_PAGESIZE));
+	bytes=(bytes+page-1)/page*page;
+	data=mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if(data==MAP_FAILED)
+	{	throw bad_alloc();
+	}
+	kind=NormalPages;
+	bytes_[kind]+=bytes;
+	return data;
+}
+
+void HugePageAllocator::deallocate(void* data, size_t const& bytes, PageKind const& kind)
+{	assert(bytes_[kind]>=bytes);
+	munmap(data, bytes);
+	bytes_[kind]-=bytes;
+}
+
+void HugePageAllocator::report(ostream& out) const
+{	for(int kind(NormalPages);kind<=HugeTLBPages;++kind)
+	{	out<<getName(PageKind(kind))<<": "<<bytes_[kind]/1024<<" kB"<<endl;
+	}
+}
+
+string HugePageAllocator::getName(PageKind const& kind)
+{	switch(kind)
+	{	case NormalPages:			return "normal pages";
+		case TransparentHugePages:	return "transparent huge pages";
+		case HugeTLBPages:			return "reserved huge pages";
+	}
+	return "";
+}
+
+size_t HugePageAllocator::getResidentHugeBytes(vector<void const*> const& data)
+{
+	ifstream smaps("/proc/self/smaps");
+	size_t bytes(0);
+	bool inside(false);
+	string line;
+
+	/*	Each mapping starts with a line "start-end permissions ...", followed by lines "Field: value kB".	*/
+	while(getline(smaps, line))
+	{	size_t dash(line.find('-'));
+		size_t space(line.find(' '));
+		if(dash!=string::npos && space!=string::npos && dash<space && line.find(':')>space)
+		{	size_t start(stoull(line.substr(0, dash), nullptr, 16));
+			size_t end(stoull(line.substr(dash+1, space-dash-1), nullptr, 16));
+			inside=false;
+			for(size_t i(0);i<data.size() && !inside;++i)
+			{	size_t address(reinterpret_cast<size_t>(data[i]));
+				inside=(address>=start && address<end);
+			}
+		} else if(inside && line.compare(0, 14, "AnonHugePages:")==0)
+		{	istringstream value(line.substr(14));
+			size_t kilobytes(0);
+			value>>kilobytes;
+			bytes+=kilobytes*1024;
+		}
+	}
+	return bytes;
+}
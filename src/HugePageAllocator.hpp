@@ -0,0 +1,86 @@
+#ifndef HUGEPAGEALLOCATOR_H
+#define HUGEPAGEALLOCATOR_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <iostream>
+
+using namespace std;
+
+/*!	Kind of pages backing an allocation.	*/
+enum PageKind
+{	NormalPages,			/**<	Pages of the system, usually 4 kB.								*/
+	TransparentHugePages,	/**<	Pages the kernel has been asked to back with 2 MB pages.		*/
+	HugeTLBPages			/**<	Pages taken from the reserved pool of 2 MB pages.				*/
+};
+
+//! HugePageAllocator class
+/*!	Allocates the large arrays of the simulation on 2 MB pages, so that random accesses over tens of
+ * 	megabytes do not miss in the TLB at each access.
+ *
+ * 	Large allocations are first taken from the reserved huge pages (MAP_HUGETLB). If none are reserved,
+ * 	the memory is aligned on 2 MB and the kernel is asked to back it with transparent huge pages
+ * 	(MADV_HUGEPAGE), whatever the system-wide setting as long as it is not "never". Small allocations,
+ * 	or all of them when huge pages are disabled, use normal pages.	*/
+class HugePageAllocator
+{
+	private:
+
+	bool enabled_;		/**<	Whether huge pages are requested.							*/
+	size_t bytes_[3];	/**<	Number of bytes mapped with each kind of pages.				*/
+
+	public:
+	static constexpr size_t HugePageSize=size_t(1)<<21;	/**<	Size of a huge page in bytes.	*/
+
+	//! Constructor
+	/*!	@param enabled: Whether huge pages are requested.	*/
+	explicit HugePageAllocator(bool enabled=true);
+
+/***************************************************/
+	/*	Getters	*/
+	//! Gets whether huge pages are requested
+	bool getEnabled() const;
+	//! Gets the number of bytes mapped with a kind of pages
+	size_t getBytes(PageKind const& kind) const;
+
+/***************************************************/
+	/*	Setters	*/
+	//! Sets whether huge pages are requested for the next allocations
+	void setEnabled(bool const& enabled);
+
+/***************************************************/
+	//!A public function taking a size and a kind of pages as parameters
+	/*!	Maps memory for an array.
+	 * 	@param bytes: Number of bytes wanted, replaced by the number of bytes mapped.
+	 * 	@param kind: Replaced by the kind of pages obtained.
+	 * 	@return Pointer on the memory, aligned on 2 MB for huge pages. Throws bad_alloc if nothing can be mapped.	*/
+	void* allocate(size_t& bytes, PageKind& kind);
+
+	//!A public function taking a pointer, a size and a kind of pages as parameters
+	/*!	Unmaps memory given by allocate.
+	 * 	@param data: Pointer returned by allocate.
+	 * 	@param bytes: Number of bytes mapped.
+	 * 	@param kind: Kind of pages obtained.	*/
+	void deallocate(void* data, size_t const& bytes, PageKind const& kind);
+
+	//!A public function taking a stream as parameter
+	/*!	Writes the number of bytes mapped with each kind of pages.
+	 * 	@param out: Stream written.	*/
+	void report(ostream& out) const;
+
+	//!A public function taking a kind of pages as parameter
+	/*!	@param kind: Kind of pages.
+	 * 	@return Name of the kind of pages.	*/
+	static string getName(PageKind const& kind);
+
+	//!A public function taking pointers as parameter
+	/*!	Reads in /proc/self/smaps how much of some mappings is actually backed by transparent huge pages,
+	 * 	which only happens once the memory has been written. Neighbouring allocations may have been merged
+	 * 	in a single mapping by the kernel, which is then counted once.
+	 * 	@param data: Addresses in the mappings.
+	 * 	@return Number of bytes of the mappings backed by huge pages.	*/
+	static size_t getResidentHugeBytes(vector<void const*> const& data);
+};
+
+#endif
@@ -25,6 +25,8 @@
 	* each neuron's buffer at each time step: one index corresponds to the time of the network, and the second one takes
 	* into consideration the delay: it starts at the index delay_steps. This way, the two indexes are always delay_steps apart
 	* from each other.
+	*  Later on, the buffers became indexed by the global time step itself: their size is rounded up to a power of 2,
+	* so that the slot of a time step is found with a mask instead of a modulo, and no index has to be advanced anymore.
 	* 
 
 
@@ -0,0 +1,170 @@
+#include "MeanField.hpp"
+#include <cassert>
+#include <algorithm>
+
+/*	Scaled complementary error function exp(x*x)*erfc(x) for x>=0, by its asymptotic series where exp overflows.	*/
+static double erfcx(double const& x)
+{	if(x<26.0)
+	{	return exp(x*x)*erfc(x);
+	}
+	return (1.0-1.0/(2.0*x*x)+3.0/(4.0*x*x*x*x))/(x*sqrt(M_PI));
+}
+
+/*	Integrand of the Siegert formula, exp(u*u)*(1+erf(u)).	*/
+static double siegertIntegrand(double const& u)
+{	return u<0.0 ? erfcx(-u) : exp(u*u)*(2.0-erfc(u));
+}
+
+/*	Integral of a function between two bounds with the Simpson rule on intervals steps.	*/
+template<typename Function>
+static double simpson(Function const& function, double const& from, double const& to, unsigned int const& intervals)
+{	double step((to-from)/intervals);
+	double sum(function(from)+function(to));
+	for(unsigned int k(1);k<intervals;++k)
+	{	sum+=(k%2==1 ? 4.0 : 2.0)*function(from+k*step);
+	}
+	return sum*step/3.0;
+}
+
+MeanField::MeanField(double relative_inhibition, double external_ratio)
+	:	relative_inhibition_(relative_inhibition), external_ratio_(external_ratio), rate_(0.0)
+{	assert(relative_inhibition_>=0.0 && external_ratio_>=0.0);
+	double refractory(RefractoryPeriod*dt);
+
+	/*	The rate of a neuron is above the rate of the network at 0, and below it at the maximal rate. The lowest
+	 * 	rate at which they cross is searched on a logarithmic grid, then by bisection.	*/
+	double low(0.0), high(0.0);
+	bool found(false);
+	for(unsigned int k(0);k<=400 && !found;++k)
+	{	high=1e-7*pow(0.999/refractory/1e-7, k/400.0);
+		if(siegert(mean(high), sigma(high))<high)
+		{	found=true;
+		} else {
+			low=high;
+		}
+	}
+	assert(found);
+	for(unsigned int k(0);k<60;++k)
+	{	double middle(0.5*(low+high));
+		if(siegert(mean(middle), sigma(middle))<middle)
+		{	high=middle;
+		} else {
+			low=middle;
+		}
+	}
+	rate_=0.5*(low+high);
+}
+
+/***************************************************/
+/*	Getters	*/
+
+double MeanField::getRate() const
+{	return rate_*1000.0;
+}
+
+double MeanField::getMean() const
+{	return mean(rate_);
+}
+
+double MeanField::getSigma() const
+{	return sigma(rate_);
+}
+
+Regime MeanField::getRegime() const
+{	if(rate_*1000.0<0.1)
+	{	return Quiescent;
+	}
+	if(rate_*RefractoryPeriod*dt>=RegimeClassifier::SaturationFraction)
+	{	return Saturated;
+	}
+	if(relative_inhibition_<4.0)
+	{	return SynchronousRegular;
+	}
+	if(external_ratio_<1.0)
+	{	return SynchronousIrregularSlow;
+	}
+	if(external_ratio_>0.7*relative_inhibition_-0.5)
+	{	return SynchronousIrregularFast;
+	}
+	return AsynchronousIrregular;
+}
+
+/***************************************************/
+
+bool MeanField::isResolved(double const& margin) const
+{	Regime regime(getRegime());
+	if(regime==Saturated || regime==Quiescent)
+	{	return true;
+	}
+	double distance(fabs(relative_inhibition_-4.0));
+	if(relative_inhibition_>4.0)
+	{	distance=min(distance, fabs(external_ratio_-1.0));
+		distance=min(distance, fabs(external_ratio_-0.7*relative_inhibition_+0.5)/sqrt(1.0+0.7*0.7));
+	}
+	return distance>=margin;
+}
+
+size_t MeanField::getExpectedSpikes(size_t const& neurons, double const& duration) const
+{	return static_cast<size_t>(ceil(neurons*rate_*duration));
+}
+
+double MeanField::getDensity(double const& potential) const
+{	if(potential>=MembraneThreshold || getRegime()==Quiescent)
+	{	return 0.0;
+	}
+	double mu(getMean()), s(getSigma());
+	double x((potential-mu)/s), threshold((MembraneThreshold-mu)/s), reset((MembraneReset-mu)/s);
+
+	/*	exp(-x*x) is brought in the integral so that nothing overflows.	*/
+	double from(max(x, reset));
+	double integral(simpson([x](double u) { return exp(u*u-x*x); }, from, threshold, 400));
+	return 2.0*rate_*Tao/s*integral;
+}
+
+vector<double> MeanField::getQuantiles(size_t const& number) const
+{	vector<double> quantiles(number, MembraneReset);
+	if(getRegime()==Quiescent)
+	{	return quantiles;
+	}
+	
+	/*	The cumulative distribution is integrated on a grid from far below the mean, and inverted.	*/
+	double low(min(MembraneReset, getMean()-8.0*getSigma())), step(0.01);
+	size_t points(static_cast<size_t>((MembraneThreshold-low)/step)+1);
+	vector<double> cumulative(points, 0.0);
+	double previous(getDensity(low));
+	for(size_t k(1);k<points;++k)
+	{	double density(getDensity(low+k*step));
+		cumulative[k]=cumulative[k-1]+0.5*(previous+density)*step;
+		previous=density;
+	}
+	size_t k(0);
+	for(size_t q(0);q<number;++q)
+	{	double probability((q+0.5)/number*cumulative.back());
+		while(k+2<points && cumulative[k+1]<probability)
+		{	++k;
+		}
+		double width(cumulative[k+1]-cumulative[k]);
+		quantiles[q]=low+step*(k+(width>0.0 ? (probability-cumulative[k])/width : 0.0));
+	}
+	return quantiles;
+}
+
+double MeanField::siegert(double const& mean, double const& sigma)
+{	assert(sigma>0.0);
+	double threshold((MembraneThreshold-mean)/sigma), reset((MembraneReset-mean)/sigma);
+	double integral(simpson(siegertIntegrand, reset, threshold, 2000));
+	return 1.0/(RefractoryPeriod*dt+Tao*sqrt(M_PI)*integral);
+}
+
+double MeanField::mean(double const& rate) const
+{	double external(external_ratio_*MembraneThreshold/(ExcitatoryAmplitude*Tao));
+	double gamma(double(NumberInhibitoryConnections)/NumberExcitatoryConnections);
+	return Tao*ExcitatoryAmplitude*(external+NumberExcitatoryConnections*rate*(1.0-relative_inhibition_*gamma));
+}
+
+double MeanField::sigma(double const& rate) const
+{	double external(external_ratio_*MembraneThreshold/(ExcitatoryAmplitude*Tao));
+	double gamma(double(NumberInhibitoryConnections)/NumberExcitatoryConnections);
+	return sqrt(Tao*ExcitatoryAmplitude*ExcitatoryAmplitude
+				*(external+NumberExcitatoryConnections*rate*(1.0+relative_inhibition_*relative_inhibition_*gamma)));
+}
@@ -0,0 +1,91 @@
+#ifndef MEANFIELD_H
+#define MEANFIELD_H
+
+#include <math.h>
+#include <string>
+#include <vector>
+#include "Utility/Constants.hpp"
+#include "RegimeClassifier.hpp"
+
+using namespace std;
+
+//! MeanField class
+/*!	Stationary state of a Brunel network predicted by the mean-field theory of the paper, in the diffusion
+ * 	approximation: the input of a neuron is a gaussian white noise of mean mu and standard deviation sigma,
+ * 	both depending on the rate nu of the network, and nu is the rate of a neuron receiving this input,
+ * 	given by the Siegert formula. The stationary rate is the lowest solution of this self-consistent equation.
+ *
+ * 	The other parameters are the ones of Utility/Constants.hpp. The regime is predicted from the rate and
+ * 	from the boundaries of the phase diagram of the paper for J=0.1 mV and D=1.5 ms: SR below g=4, then
+ * 	SI slow below eta=1, SI fast above eta=0.7g-0.5 and AI in between. These lines are approximations of
+ * 	the stability analysis, so points close to them have to be simulated.	*/
+class MeanField
+{
+	private:
+	double relative_inhibition_;	/**<	g, ratio of the inhibitory and excitatory amplitudes.					*/
+	double external_ratio_;			/**<	eta, external frequency over threshold frequency.						*/
+	double rate_;					/**<	Stationary rate of the neurons, in spikes per ms.						*/
+
+	public:
+	//! Constructor
+	/*!	Solves the self-consistent equation of the rate.
+	 * 	@param relative_inhibition: g, ratio of the inhibitory and excitatory amplitudes.
+	 * 	@param external_ratio: eta, external frequency over threshold frequency.	*/
+	explicit MeanField(double relative_inhibition=g, double external_ratio=eta);
+
+/***************************************************/
+	/*	Getters	*/
+	//! Gets the stationary rate of the neurons, in Hz
+	double getRate() const;
+	//! Gets the mean input of the neurons at the stationary rate, in mV
+	double getMean() const;
+	//! Gets the standard deviation of the input of the neurons at the stationary rate, in mV
+	double getSigma() const;
+	//! Gets the predicted regime
+	Regime getRegime() const;
+
+/***************************************************/
+	//!A public function taking a double as parameter
+	/*!	@param margin: Smallest distance to a boundary of the phase diagram, in units of g and eta.
+	 * 	@return bool: Whether the point is far enough from the boundaries for its regime to be trusted.	*/
+	bool isResolved(double const& margin=0.5) const;
+
+	//!A public function taking a number of neurons and a duration as parameters
+	/*!	@param neurons: Number of neurons recorded.
+	 * 	@param duration: Duration of the simulation in ms.
+	 * 	@return size_t: Number of spikes expected at the stationary rate, to size buffers.	*/
+	size_t getExpectedSpikes(size_t const& neurons, double const& duration) const;
+
+	//!A public function taking a double as parameter
+	/*!	Stationary distribution of the membrane potential of a neuron which is not refractory, equation 22
+	 * 	of the paper: its integral over ]-inf, threshold] is 1-rate*RefractoryPeriod.
+	 * 	@param potential: Membrane potential in mV.
+	 * 	@return double: Probability density per mV, 0 in a quiescent network, whose potentials stay at rest.	*/
+	double getDensity(double const& potential) const;
+
+	//!A public function taking a number as parameter
+	/*!	@param number: Number of quantiles wanted.
+	 * 	@return vector<double>: Membrane potentials below which are the fractions (k+0.5)/number of the neurons
+	 * 	which are not refractory, in the stationary distribution, or reset potentials in a quiescent network.	*/
+	vector<double> getQuantiles(size_t const& number) const;
+
+	//!A public function taking two doubles as parameters
+	/*!	Siegert formula: rate of a leaky integrate-and-fire neuron receiving a gaussian white noise.
+	 * 	@param mean: Mean of the input in mV.
+	 * 	@param sigma: Standard deviation of the input in mV.
+	 * 	@return double: Rate in spikes per ms.	*/
+	static double siegert(double const& mean, double const& sigma);
+
+	private:
+	//!A private function taking a rate as parameter
+	/*!	@param rate: Rate of the network in spikes per ms.
+	 * 	@return double: Mean input of a neuron in mV.	*/
+	double mean(double const& rate) const;
+
+	//!A private function taking a rate as parameter
+	/*!	@param rate: Rate of the network in spikes per ms.
+	 * 	@return double: Standard deviation of the input of a neuron in mV.	*/
+	double sigma(double const& rate) const;
+};
+
+#endif
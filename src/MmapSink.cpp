@@ -0,0 +1,102 @@
+#include "MmapSink.hpp"
+#include "SpikeReplay.hpp"
+#include <cassert>
+#include <cerrno>
+#include <iostream>
+#include <system_error>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+MmapSink::MmapSink(string const& path, size_t capacity)
+	:	path_(path), file_(-1), capacity_(capacity), size_(sizeof(SpikeReplay::Header)+4*capacity), data_(nullptr),
+		neurons_(nullptr), events_(0), sources_(0), offsets_(1, 0), lost_(0)
+{	file_=open(path_.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+	if(file_<0)
+	{	throw system_error(errno, generic_category(), "MmapSink: cannot create "+path_);
+	}
+	void* region(MAP_FAILED);
+	if(ftruncate(file_, size_)==0)
+	{	region=mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, file_, 0);
+	}
+	if(region==MAP_FAILED)
+	{	int error(errno);
+		::close(file_);
+		throw system_error(error, generic_category(), "MmapSink: cannot map "+path_);
+	}
+	data_=static_cast<char*>(region);
+	neurons_=reinterpret_cast<uint32_t*>(data_+sizeof(SpikeReplay::Header));
+}
+
+MmapSink::~MmapSink()
+{	
+	/*	A destructor cannot throw, so a file which cannot be completed is only reported.	*/
+	if(file_>=0 && !close())
+	{	cerr<<"MmapSink: cannot complete "<<path_<<endl;
+	}
+}
+
+/***************************************************/
+/*	Getters	*/
+
+size_t MmapSink::getEvents() const
+{	return events_;
+}
+
+size_t MmapSink::getLost() const
+{	return lost_;
+}
+
+/***************************************************/
+
+bool MmapSink::close()
+{	if(file_<0)
+	{	return true;
+	}
+	munmap(data_, size_);
+	data_=nullptr;
+	neurons_=nullptr;
+
+	/*	The steps follow the spikes written, and the header is written last.	*/
+	SpikeReplay::Header header = {SpikeReplay::Magic, sources_, static_cast<uint32_t>(offsets_.size()), 0, events_};
+	if(events_==0)
+	{	header.steps=0;
+		offsets_.assign(1, 0);
+	} else {
+		offsets_.push_back(events_);
+	}
+	size_t position(SpikeReplay::getOffsetsPosition(events_));
+	bool completed(ftruncate(file_, position+offsets_.size()*sizeof(uint64_t))==0
+					&& pwrite(file_, offsets_.data(), offsets_.size()*sizeof(uint64_t), position)
+						==static_cast<ssize_t>(offsets_.size()*sizeof(uint64_t))
+					&& pwrite(file_, &header, sizeof(header), 0)==static_cast<ssize_t>(sizeof(header)));
+	completed=(::close(file_)==0) && completed;
+	file_=-1;
+	return completed;
+}
+
+void MmapSink::writeSpike(unsigned int const& step, unsigned int const& neuron, double const&)
+{	assert(file_>=0);
+	if(events_==capacity_)
+	{	++lost_;
+		return;
+	}
+	reach(step);
+	neurons_[events_++]=neuron;
+	if(neuron>=sources_)
+	{	sources_=neuron+1;
+	}
+}
+
+void MmapSink::writeStep(unsigned int const& step, unsigned int const&)
+{	reach(step);
+}
+
+void MmapSink::reach(unsigned int const& step)
+{	
+	/*	offsets_ holds the first spike of the steps 0 to the last one written.	*/
+	assert(step+1>=offsets_.size());
+	while(offsets_.size()<=step)
+	{	offsets_.push_back(events_);
+	}
+}
@@ -0,0 +1,70 @@
+#ifndef MMAPSINK_H
+#define MMAPSINK_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "OutputSink.hpp"
+
+using namespace std;
+
+//! MmapSink class
+/*!	Writes the spikes in a binary spike file, replayable by SpikeReplay, through a mapping of the file sized
+ * 	for a number of spikes when the sink is created: a spike is a word stored in the mapping, without any
+ * 	formatting nor system call. The index of the first spike of each step is kept in memory and written
+ * 	after the spikes when the sink is closed, the file being cut to its final size.
+ *
+ * 	The spikes beyond the capacity are lost, and counted. The potentials are not kept.	*/
+class MmapSink : public OutputSink
+{
+	private:
+	string path_;					/**<	Name of the binary spike file.							*/
+	int file_;						/**<	Descriptor of the file.									*/
+	size_t capacity_;				/**<	Number of spikes the mapping can hold.					*/
+	size_t size_;					/**<	Size of the mapping in bytes.							*/
+	char* data_;					/**<	Mapping of the file.									*/
+	uint32_t* neurons_;				/**<	Neurons spiking, step after step, in the mapping.		*/
+	uint64_t events_;				/**<	Number of spikes written.								*/
+	uint32_t sources_;				/**<	Index of the last neuron which spiked + 1.				*/
+	vector<uint64_t> offsets_;		/**<	First spike of each step written.						*/
+	size_t lost_;					/**<	Number of spikes beyond the capacity.					*/
+
+	public:
+	//! Constructor
+	/*!	Creates the file, with the size of the spikes wanted. Throws a system_error if the file cannot be
+	 * 	created or mapped.
+	 * 	@param path: Name of the binary spike file.
+	 * 	@param capacity: Number of spikes, for instance MeanField::getExpectedSpikes.	*/
+	MmapSink(string const& path, size_t capacity);
+
+	MmapSink(MmapSink const&) = delete;
+	MmapSink& operator=(MmapSink const&) = delete;
+
+	//! Destructor
+	/*!	Closes the file if it is still open, a failure only being reported on the error output.	*/
+	~MmapSink();
+
+/***************************************************/
+	/*	Getters	*/
+	//! Gets the number of spikes written
+	size_t getEvents() const;
+	//! Gets the number of spikes lost beyond the capacity
+	size_t getLost() const;
+
+/***************************************************/
+	//!A public function
+	/*!	Writes the header and the steps of the file, and closes it. No spike can be written afterwards.
+	 * 	@return bool: Whether the file is complete, false if it could not be written.	*/
+	bool close();
+
+	void writeSpike(unsigned int const& step, unsigned int const& neuron, double const& potential) override;
+	void writeStep(unsigned int const& step, unsigned int const& spikes) override;
+
+	private:
+	//!A private function taking a time step as parameter
+	/*!	Starts the steps up to a time step, the steps skipped having no spike.
+	 * 	@param step: Time step.	*/
+	void reach(unsigned int const& step);
+};
+
+#endif
@@ -1,37 +1,38 @@
 #include "Network.hpp"
+#include "MeanField.hpp"
 #include <cassert>
 #include <iostream>
 #include <fstream>
+#include <limits>
+#include <algorithm>
 
-Network::Network(	bool all, bool random, vector<Neuron*> new_neur, unsigned int clock, unsigned int read, unsigned int write)
+const size_t Network::IntegrationTask;
+const size_t Network::SmallBlock;
+const size_t Network::DeliveryTask;
 
-	: 				all_(all), random_wanted_(random), neurons_(new_neur), clock_time_(clock), index_read_(read), 
-					index_write_(write)
-		
-{		/*	Random devices useful to calculate the random connectivity of neurons.	*/
-		random_device rd;
-		generator=mt19937(rd());
-		distribution=poisson_distribution<unsigned int>(ExternalFrequency*dt);
-		
-		/*	Opening of file to contain number of spikes at each dt step.	*/
-		file.open("spikes.txt");
-		assert(!file.fail());
-		
-		/*	Opening of file to contain id of neurons having spiked at each dt step.	*/
-		f.open("jupyterplot.txt");
-		assert(!f.fail());
+Network::Network(	bool all, bool random, unsigned int clock, InitialPotential initial)
+
+	:				Network(all, random, make_shared<FileSink>(all), clock, initial)
+{}
+
+Network::Network(	bool all, bool random, shared_ptr<OutputSink> output, unsigned int clock, InitialPotential initial)
+
+	: 				all_(all), random_wanted_(random), arena_(all ? HugePageAllocator::HugePageSize : SmallBlock, all), clock_time_(clock), initial_(initial),
+					random_(random_device()()), poisson_(ExternalFrequency*dt), input_(PoissonInput), decay_(0.0), source_(nullptr), stimuli_(nullptr), statistics_(nullptr), classifier_(nullptr),
+					spectrum_(nullptr), scheduler_(nullptr), output_(output)
 		
+{		
+	/*	The spikes are written in the output chosen.	*/
+	assert(output_);
+	
 	/*	If the user wishes to have all 12500 neurons in the network, these are added the following way:
 	 * 	for simplicity reasons, the first 10000 neurons will be excitatory and the rest will be 
 	 * 	inhibitory. Then, random connections are established, from which 1000 are excitatory connections,
 	 * 	and 250 are inhibitory.	*/
 	if(all_)
 	{	
-		/*	The matrix of links between neurons is initialized to a size of 12500 by 1250, since every
-		 * 	neuron is required to have 1250 connections.	*/
-		links_=vector<vector<unsigned int>>(TotalNeurons, vector<unsigned int>(TotalConnections));
-		
-		/*	The vector containing all neurons is resized to 12500.	*/
+		/*	The 12500 neurons are constructed next to each other in the arena.	*/
+		Neuron* block(arena_.allocateArray<Neuron>(TotalNeurons));
 		neurons_.resize(TotalNeurons);
 		
 		/*	Addition of 10000 excitatory neurons,
@@ -43,23 +44,45 @@ Network::Network(	bool all, bool random, vector<Neuron*> new_neur, unsigned int
 			if(i<NumberExcitatoryNeurons)
 			{	excit=true;
 			}
-			neurons_[i]=new Neuron(excit);
+			neurons_[i]=new(block+i) Neuron(excit);
 		}
+		
+		/*	The matrix of links between neurons has a size of 12500 by 1250, since every
+		 * 	neuron is required to have 1250 connections. It is stored in the connectivity of the network.	*/
+		connectivity_=make_shared<Connectivity>();
 		/*	We initialize the connections within the network. These are generated randomly. */
 		initializeConnections();
+		
+		/*	The neurons start at rest unless another strategy is wanted.	*/
+		if(initial_!=ZeroPotentials)
+		{	initializePotentials(initial_);
+		}
 	}
 	
 }
 
+Network::Network(Network const& parent, unsigned int seed, shared_ptr<OutputSink> output)
+
+	:	all_(parent.all_), random_wanted_(parent.random_wanted_), arena_(all_ ? HugePageAllocator::HugePageSize : SmallBlock, all_),
+		clock_time_(parent.clock_time_), initial_(parent.initial_), connectivity_(parent.connectivity_), random_(seed), poisson_(parent.poisson_),
+		input_(parent.input_), decay_(parent.decay_), noise_(parent.noise_), noise_time_(parent.noise_time_),
+		source_(nullptr), stimuli_(nullptr),
+		statistics_(nullptr), classifier_(nullptr), spectrum_(nullptr), scheduler_(nullptr), output_(output)
+{	assert(output_);
+	
+	/*	Only the state of the neurons is copied, next to each other in the arena of the child. The parent has
+	 * 	brought its parked neurons up to its clock time at the end of its last simulation.	*/
+	Neuron* block(arena_.allocateArray<Neuron>(parent.neurons_.size()));
+	neurons_.resize(parent.neurons_.size());
+	for(size_t i(0);i<neurons_.size();++i)
+	{	neurons_[i]=new(block+i) Neuron(*parent.neurons_[i]);
+	}
+}
+
 Network::~Network()
-{	/*	The destructor sets all neurons to nullptr, deletes them,
-		and clears the vector.	*/
+{	/*	The destructor destroys all neurons and releases the arena.	*/
 
 	clearNeurons();
-	
-	/*	Closing all files used to store values.	*/
-	f.close();
-	file.close();
 }
 /***************************************************/
 /*	Getters	*/
@@ -68,12 +91,77 @@ unsigned int Network::getClockTime() const
 {	return clock_time_;
 }
 
-vector<Neuron*> Network::getNeurons() const
-{	return neurons_;
+View<Neuron* const> Network::getNeurons() const
+{	return View<Neuron* const>(neurons_.data(), neurons_.size());
+}
+
+PotentialView Network::getPotentials() const
+{	return PotentialView(getNeurons());
 }
 
 matrix Network::getLinks() const
-{	return links_;
+{	return connectivity_ ? connectivity_->getLinks() : matrix();
+}
+
+View<unsigned int const> Network::getLinkRow(unsigned int const& neuron) const
+{	assert(connectivity_);
+	return connectivity_->getLinkRow(neuron);
+}
+
+unsigned int Network::getMinDelay() const
+{	return connectivity_ ? connectivity_->getMinDelay() : delay_steps;
+}
+
+unsigned int Network::getMaxDelay() const
+{	return connectivity_ ? connectivity_->getMaxDelay() : delay_steps;
+}
+
+shared_ptr<Connectivity const> Network::getConnectivity() const
+{	return connectivity_;
+}
+
+SpikeStatistics* Network::getStatistics() const
+{	return statistics_;
+}
+
+RegimeClassifier* Network::getClassifier() const
+{	return classifier_;
+}
+
+SpectralEstimator* Network::getSpectralEstimator() const
+{	return spectrum_;
+}
+
+TaskScheduler* Network::getScheduler() const
+{	return scheduler_;
+}
+
+bool Network::hasRandomSpikes() const
+{	return random_wanted_ && source_==nullptr;
+}
+
+unsigned int Network::getSeed() const
+{	return random_.getSeed();
+}
+
+ExternalInput Network::getExternalInput() const
+{	return input_;
+}
+
+SpikeSource* Network::getSpikeSource() const
+{	return source_;
+}
+
+StimulusSchedule* Network::getStimuli() const
+{	return stimuli_;
+}
+
+OutputSink& Network::getOutput() const
+{	return *output_;
+}
+
+Arena const& Network::getArena() const
+{	return arena_;
 }
 /***************************************************/
 /*	Setters	*/
@@ -82,32 +170,118 @@ void Network::setClockTime(unsigned int const& new_time)
 {	clock_time_=new_time;
 }
 
-void Network::setNeurons(vector<Neuron*> const& new_neurons)
-{	/*	Before affecting new pointers, clears the vector.	*/
+void Network::setNeurons(vector<Neuron> const& new_neurons)
+{	/*	Before adding the new neurons, clears the network.	*/
 	clearNeurons();
 	for(size_t i(0);i<new_neurons.size();++i)
 	{	
-		/*	The new pointers on Neurons are added to the vector.	*/
-		neurons_.push_back(new_neurons[i]);
+		/*	Copies of the new neurons are constructed in the arena.	*/
+		addNeuron(new_neurons[i]);
 	}
 }
 
+void Network::setHistoryCapacity(size_t const& capacity)
+{	for(size_t i(0);i<neurons_.size();++i)
+	{	neurons_[i]->setHistoryCapacity(capacity);
+	}
+}
+
+void Network::setStatistics(SpikeStatistics* statistics)
+{	statistics_=statistics;
+}
+
+void Network::setClassifier(RegimeClassifier* classifier)
+{	classifier_=classifier;
+}
+
+void Network::setSpectralEstimator(SpectralEstimator* spectrum)
+{	spectrum_=spectrum;
+}
+
+void Network::setScheduler(TaskScheduler* scheduler)
+{	scheduler_=scheduler;
+}
+
+void Network::setHugePages(bool const& huge_pages)
+{	arena_.setHugePages(huge_pages);
+}
+
+void Network::setDelays(unsigned int const& min, unsigned int const& max)
+{	assert(connectivity_);
+	
+	/*	A connectivity shared with other networks is copied first.	*/
+	if(connectivity_.use_count()>1)
+	{	connectivity_=make_shared<Connectivity>(*connectivity_);
+	}
+	connectivity_->setDelays(random_, min, max);
+	
+	for(size_t i(0);i<neurons_.size();++i)
+	{	neurons_[i]->setMaxDelay(max);
+	}
+}
+
+void Network::setExternalInput(ExternalInput const& input, double const& correlation_time)
+{	assert(random_wanted_ && correlation_time>0.0);
+	input_=input;
+	decay_=exp(-dt/correlation_time);
+	
+	/*	The noise of a neuron is drawn from its stationary distribution the first time.	*/
+	noise_.assign(neurons_.size(), 0.0);
+	noise_time_.assign(neurons_.size(), numeric_limits<unsigned int>::max());
+}
+
+void Network::setSpikeSource(SpikeSource* source)
+{	source_=source;
+	if(source_!=nullptr)
+	{	source_->reset(clock_time_);
+	}
+}
+
+void Network::setStimuli(StimulusSchedule* stimuli)
+{	
+	/*	The inputs of the neurons are put back before the new stimuli are added.	*/
+	if(stimuli_!=nullptr)
+	{	for(size_t i(0);i<neurons_.size() && i<base_inputs_.size();++i)
+		{	neurons_[i]->setInput(base_inputs_[i]);
+		}
+	}
+	stimuli_=stimuli;
+	if(stimuli_!=nullptr)
+	{	stimuli_->reset(neurons_.size());
+		readInputs();
+		applyStimuli(0, neurons_.size());
+	}
+}
+
+void Network::setSeed(unsigned int const& seed)
+{	random_.setSeed(seed);
+	if(all_ && connectivity_)
+	{	initializeConnections();
+	}
+	if(initial_!=ZeroPotentials)
+	{	initializePotentials(initial_);
+	}
+}
 
 /***************************************************/
-void Network::addNeuron(Neuron* neuron_to_add)
-{	/*	Adds a neuron to the vector of neurons in the network.	*/
-	neurons_.push_back(neuron_to_add);
+Neuron* Network::addNeuron(Neuron const& neuron_to_add)
+{	/*	Adds a copy of the neuron, constructed in the arena, to the vector of neurons in the network.	*/
+	neurons_.push_back(arena_.create<Neuron>(neuron_to_add));
+	return neurons_.back();
 }
 
 void Network::clearNeurons()
-{	/*	First sets all pointers to nullptr and deletes them.	*/
+{	/*	The neurons are destroyed in place, their memory belongs to the arena.	*/
 	for(size_t i(0);i<neurons_.size();++i)
-	{	neurons_[i]=nullptr;
-		delete neurons_[i];
+	{	neurons_[i]->~Neuron();
 	}
 	
-	/*	It will leave an empty vector with a size of 0.	*/
+	/*	It will leave an empty vector with a size of 0, and no links.	*/
 	neurons_.clear();
+	connectivity_.reset();
+	
+	/*	All the memory is released at once.	*/
+	arena_.release();
 }
 
 void Network::createLink(vector<unsigned int> neurons_to_link)
@@ -142,149 +316,386 @@ void Network::createLink(vector<unsigned int> neurons_to_link)
 }
 
 void Network::initializeConnections()
-{	
-	/*	Iteration in all neurons, since each of them need to be connected to other neurons.	*/
-	for(size_t i(0);i<TotalNeurons;++i)
-	{	
+{	/*	The links are drawn in the connectivity of the network, copied first if it is shared.	*/
+	if(connectivity_.use_count()>1)
+	{	connectivity_=make_shared<Connectivity>(*connectivity_);
+	}
+	connectivity_->initializeConnections(random_);
+}
 
-		/*	Each neuron receives an input of 10% from all other neurons, from which 1000 connections
-		 * 	are excitatory and 250 are inhibitory.	*/
-		for(size_t j(0);j<TotalConnections;++j)
-		{	
-			/*	Call of the method uniform to chose a random integer.	*/
-			if(j<NumberExcitatoryConnections)
-			{	
-				/*	The link can be any excitatory neuron. */
-				links_[i][j]=uniform(0, NumberExcitatoryNeurons);
-			}else{
-				
-				/*	The link can be any inhibitory neuron.	*/
-				links_[i][j]=uniform(NumberExcitatoryNeurons, TotalNeurons);
-			}
+void Network::initializePotentials(InitialPotential const& initial)
+{	initial_=initial;
+	
+	/*	The stationary distribution is tabulated by quantiles, between which the potentials are interpolated.	*/
+	size_t const number(1024);
+	vector<double> quantiles;
+	double refractory(0.0);
+	if(initial_==StationaryPotentials)
+	{	MeanField mean_field;
+		quantiles=mean_field.getQuantiles(number);
+		refractory=mean_field.getRate()/1000.0*RefractoryPeriod*dt;
+	}
+	
+	for(size_t i(0);i<neurons_.size();++i)
+	{	double u(random_.uniform(InitialStream, i, 0));
+		double potential(0.0);
+		unsigned int refractory_time(0);
+		switch(initial_)
+		{	case ZeroPotentials:
+				break;
+			case UniformPotentials:
+				potential=MembraneReset+u*(MembraneThreshold-MembraneReset);
+				break;
+			case StationaryPotentials:
+				if(u<refractory)
+				{	/*	A refractory neuron is at the reset potential until the end of its refractory period.	*/
+					potential=MembraneReset;
+					refractory_time=random_.uniform(InitialStream, i, 1, 1, RefractoryPeriod);
+				} else {
+					double x((u-refractory)/(1.0-refractory)*number-0.5);
+					size_t k(min(static_cast<size_t>(max(x, 0.0)), number-2));
+					double w(min(max(x-k, 0.0), 1.0));
+					potential=(1.0-w)*quantiles[k]+w*quantiles[k+1];
+				}
+				break;
 		}
+		neurons_[i]->setMembranePotential(potential);
+		neurons_[i]->setRefractoryTime(refractory_time);
 	}
 }
 	
 
-unsigned int Network::uniform(unsigned int const& min, unsigned int const& max)
+unsigned int Network::randomSpikes(unsigned int const& neuron) const
 {	
-	/*	Use of uniform_int_distribution to generate a random integer between min and max.	*/
-	uniform_int_distribution<unsigned int> uni(min, max-1);
-	
-	return uni(generator);
+	/*	The Poisson number is drawn from the uniform number of the neuron at the present time step.	*/
+	return poisson_(random_.uniform(NoiseStream, neuron, clock_time_));
 }
-unsigned int Network::randomSpikes()
-{	
-	/*	Use of poisson generator to generate a random integer. 	*/
-	return distribution(generator);
+
+Real Network::externalInput(unsigned int const& neuron)
+{	if(input_==PoissonInput)
+	{	return randomSpikes(neuron)*Real(Amplitude);
+	}
+	
+	double mean(ExternalFrequency*dt), z(random_.gaussian(NoiseStream, neuron, clock_time_));
+	if(input_==OrnsteinUhlenbeckInput)
+	{	/*	After k time steps, the noise keeps decay^k of its value, and its variance is completed by z.	*/
+		if(noise_time_[neuron]==numeric_limits<unsigned int>::max())
+		{	noise_[neuron]=z;
+		} else if(noise_time_[neuron]!=clock_time_)
+		{	double decay(pow(decay_, clock_time_-noise_time_[neuron]));
+			noise_[neuron]=noise_[neuron]*decay+sqrt(1.0-decay*decay)*z;
+		}
+		noise_time_[neuron]=clock_time_;
+		z=noise_[neuron];
+	}
+	return Real(Amplitude*(mean+sqrt(mean)*z));
 }
 void Network::update(double const& endtime)
 {	
 	/*	Conversion of the time given in time steps.	*/
 	unsigned int end(endtime/dt);
 	
-	/*	Initialization of the number of spikes and the number of random spikes to 0.	*/
-	unsigned int number_spikes(0);
-	unsigned int randomspikes(0);
+	/*	Set to true when the classifier has decided the regime of the network.	*/
+	bool finished(classifier_!=nullptr && classifier_->isFinished());
+	
+	/*	The inputs may have been set since the last simulation.	*/
+	if(stimuli_!=nullptr)
+	{	readInputs();
+	}
+	
+	/*	All neurons start in the active set.	*/
+	activate(0, neurons_.size());
 
 	/*	While the clock time is within the interval...	*/
-	while(clock_time_<end)
+	while(clock_time_<end && !finished)
 	{		
 		/*	Verifies if there are neurons in the network.	*/
 		assert(!neurons_.empty());
 		
-			/*	Iteration in all neurons contained in the network.	*/
-			for(size_t i(0);i<neurons_.size();++i)
-			{	
-				/*	If random spikes are wanted, we use the poisson distribution. */
-				if(random_wanted_)
-				{	randomspikes=randomSpikes(); 
-				}
-				
-				/*	If neuron i spikes, it will transmit its signal to all the neurons it is linked to (found in the 
-				 * 	matrix links_). */
-				if(neurons_[i]->update(randomspikes, index_read_))
-				{	
-					/*	The number of spikes increments.	*/
-					++number_spikes;
-					
-					/*	Depending on whether the user considers all 12500 neurons or not, the update method will
-					 * 	slightly change.	*/
-					if(all_)
-					{	
-						/*	The file conserves the neuron id and the particular time at which the spike
-						 * 	occurred.	*/
-							f<<clock_time_<<" "<<i<<endl;
-							
-						/*	As previously explained, we need to transmit the signal of the spiked neurons to
-						 * 	the neurons it is linked to: this is done by iterating in the matrix. */	
-							for(size_t j(0);j<TotalConnections;++j)
-							{	
-								/*	The initialization of the matrix has been done so that all excitatory 
-								 * 	neurons are within the range [0, NumberExcitatoryNeurons[, and the rest
-								 * 	are inhibitory.	*/
-								 
-								 /*	We test if the neuron spiked is excitatory or not, in which cases the amplitudes
-								  * delivered will differ: +ExcitatoryAmplitude or -InhibitoryAmplitude. 
-								  * 	
-								  * Each neuron will receive the spike after a certain delay, meaning at index
-								  * index_write in their individual buffers.	*/
-								if(i<NumberExcitatoryNeurons)
-								{	
-									neurons_[links_[i][j]]->receive(index_write_, ExcitatoryAmplitude);
-
-								} else {
-
-									neurons_[links_[i][j]]->receive(index_write_, InhibitoryAmplitude);
-								}
-							}
-					} else {
-						/*	If the amount of neurons is not of 12500 (useful for testing two neurons),
-						 * 	we iterate in all the linked neurons of the neuron having spiked, and transmit
-						 * 	the signal with an amplitude Amplitude.	*/
-						 
-						 /*	In this case, the file "jupyterplot.txt" will stock the index of the neuron having spiked and its
-						  * membrane potential, which should equal to 0 since after a spike, the membrane potential is set to 0.	*/
-						f<<i+1<<" "<<neurons_[i]->getMembranePotential()<<endl;
-						for(auto& linked: neurons_[i]->getLinkedNeurons())
-						{	
-							neurons_[linked]->receive(index_write_, Amplitude);
-						}
-						
-					}
-				}
-					
-				}
-		/*	The indexes are updated at each time step of the simulation	.*/
-		updateBuffer();
+		/*	The inputs changed by the stimuli and the external spikes are read during the time step at which
+		 * 	they occur.	*/
+		if(stimuli_!=nullptr)
+		{	applyStimuli(0, neurons_.size());
+		}
+		if(source_!=nullptr)
+		{	fireExternal(0, neurons_.size());
+		}
+		
+		/*	All neurons contained in the network are updated, and the ones which spiked are kept.	*/
+		spikes_.clear();
+		if(scheduler_==nullptr)
+		{	integrate(0, neurons_.size(), spikes_);
+		} else {
+			integrateShared();
+		}
 		
-		/*	This file keeps track of the number of spikes occurring at each time step.	*/
-		 file<<clock_time_<<" "<<number_spikes<<endl;
+		/*	Each neuron which spiked transmits its signal to all the neurons it is linked to. The spikes are only
+		 * 	read after the shortest delay, so they can be delivered once all neurons have been updated.	*/
+		for(size_t k(0);k<spikes_.size();++k)
+		{	recordSpike(spikes_[k], neurons_[spikes_[k]]->getMembranePotential());
+			if(scheduler_==nullptr)
+			{	transmit(spikes_[k]);
+			}
+		}
+		if(scheduler_!=nullptr)
+		{	transmitShared();
+		}
+		
+		finished=recordStep(spikes_.size());
 		 
 		/*	Makes the overall simulation time evolve.	*/
 		++clock_time_;	
-		
-		/*	Reset the number of spikes.*/
-		number_spikes=0;
 	}	
+	
+	/*	Parked neurons are brought up to the clock time of the network, so that their state can be read
+	 * 	or modified before the next simulation.	*/
+	synchronize(0, neurons_.size());
+}
+
+void Network::fireExternal(size_t const& begin, size_t const& end)
+{	
+	/*	Each spike of a source is read once and written in the buffers of all its targets in the range,
+	 * 	which are sorted.	*/
+	View<unsigned int const> spikes(source_->fire(clock_time_));
+	Projection const& projection(source_->getProjection());
+	double amplitude(source_->getAmplitude());
+	for(size_t k(0);k<spikes.size();++k)
+	{	View<unsigned int const> targets(projection.getTargets(spikes[k]));
+		unsigned int const* first(lower_bound(targets.begin(), targets.end(), begin));
+		unsigned int const* last(lower_bound(first, targets.end(), end));
+		for(;first!=last;++first)
+		{	deliver(*first, amplitude, clock_time_);
+		}
+	}
+}
+
+void Network::applyStimuli(size_t const& begin, size_t const& end)
+{	stimuli_->apply(clock_time_, [this, begin, end](unsigned int neuron, double current)
+	{	if(neuron<begin || neuron>=end)
+		{	return;
+		}
+		
+		/*	A parked neuron has to relax with its previous input until the present time step.	*/
+		if(neuron<wake_time_.size() && wake_time_[neuron]>clock_time_)
+		{	neurons_[neuron]->advanceTo(clock_time_);
+			if(neurons_[neuron]->getRefractoryTime()==0)
+			{	wake_time_[neuron]=clock_time_;
+			}
+		}
+		neurons_[neuron]->setInput(base_inputs_[neuron]+current);
+	});
+}
+
+void Network::readInputs()
+{	base_inputs_.resize(neurons_.size());
+	for(size_t i(0);i<neurons_.size();++i)
+	{	base_inputs_[i]=neurons_[i]->getInput()-stimuli_->getCurrent(i);
+	}
+}
+
+View<unsigned int const> Network::getTargets(unsigned int const& neuron) const
+{	/*	With all 12500 neurons, the targets are in the row of the matrix links_, otherwise they are
+	 * 	the neurons linked to the neuron.	*/
+	if(all_)
+	{	return getLinkRow(neuron);
+	}
+	return neurons_[neuron]->getLinkedNeurons();
+}
+
+View<unsigned int const> Network::getTargets(unsigned int const& neuron, unsigned int const& delay) const
+{	/*	The links of the neurons all have the delay delay_steps.	*/
+	if(!all_)
+	{	return delay==delay_steps ? getTargets(neuron) : View<unsigned int const>(nullptr, 0);
+	}
+	return connectivity_->getTargets(neuron, delay);
+}
+
+double Network::getAmplitude(unsigned int const& neuron) const
+{	/*	The initialization of the matrix has been done so that all excitatory neurons are within the range
+	 * 	[0, NumberExcitatoryNeurons[, and the rest are inhibitory. Without all 12500 neurons (useful for 
+	 * 	testing two neurons), the signal is transmitted with an amplitude Amplitude.	*/
+	if(!all_)
+	{	return Amplitude;
+	}
+	return neuron<NumberExcitatoryNeurons ? ExcitatoryAmplitude : InhibitoryAmplitude;
+}
+
+void Network::activate(size_t const& begin, size_t const& end)
+{	wake_time_.resize(neurons_.size());
+	last_arrival_.resize(neurons_.size());
+	
+	/*	Neurons added since the kind of input was set draw their noise from its stationary distribution.	*/
+	if(input_==OrnsteinUhlenbeckInput)
+	{	noise_.resize(neurons_.size(), 0.0);
+		noise_time_.resize(neurons_.size(), numeric_limits<unsigned int>::max());
+	}
+	
+	/*	Spikes written during a previous simulation may still be waiting in the buffers for up to the longest delay.	*/
+	for(size_t i(begin);i<end;++i)
+	{	wake_time_[i]=clock_time_;
+		last_arrival_[i]=clock_time_+getMaxDelay();
+	}
+}
 
+void Network::integrate(size_t const& begin, size_t const& end, vector<unsigned int>& spikes)
+{	
+	/*	Initialization of the external input to 0. A source of external spikes replaces the random spikes.	*/
+	Real external(0.0);
+	bool random(hasRandomSpikes());
 	
+	/*	Iteration in the neurons of the range.	*/
+	for(size_t i(begin);i<end;++i)
+	{	
+		/*	Parked neurons are skipped until they wake up.	*/
+		if(wake_time_[i]>clock_time_)
+		{	continue;
+		}
+		
+		/*	A neuron woken up catches up on the time steps it has been parked.	*/
+		neurons_[i]->advanceTo(clock_time_);
+		
+		/*	If random spikes are wanted, we use the poisson distribution or its diffusion approximation.	*/
+		if(random)
+		{	external=externalInput(i); 
+		}
+		
+		if(neurons_[i]->updateInput(external, clock_time_))
+		{	spikes.push_back(i);
+		}
+		
+		/*	The neuron leaves the active set if it has become refractory or quiescent. With threads, all
+		 * 	neurons stay active, since the delivery of the spikes cannot update the active set.	*/
+		if(scheduler_==nullptr)
+		{	park(i);
+		}
+	}
+}
+
+void Network::integrateShared()
+{	
+	/*	Each task updates a range of neurons, and the spikes of the ranges are put back in order.	*/
+	size_t tasks((neurons_.size()+IntegrationTask-1)/IntegrationTask);
+	task_spikes_.resize(tasks);
+	scheduler_->run(tasks, [this](size_t task)
+	{	task_spikes_[task].clear();
+		integrate(task*IntegrationTask, min(neurons_.size(), (task+1)*IntegrationTask), task_spikes_[task]);
+	});
+	for(size_t t(0);t<tasks;++t)
+	{	spikes_.insert(spikes_.end(), task_spikes_[t].begin(), task_spikes_[t].end());
+	}
 }
 
-void Network::updateBuffer()
-{	/*	Incrementation of both indexes, if either goes further than the size of the buffer(delay_steps+1),
-		it will be put back to 0.	*/
-	++index_read_;
-	if(index_read_>delay_steps)
-	{	index_read_=0;
+void Network::transmitShared()
+{	
+	/*	Each task delivers a few spikes. Several tasks may write in the buffer of the same neuron.	*/
+	size_t tasks((spikes_.size()+DeliveryTask-1)/DeliveryTask);
+	scheduler_->run(tasks, [this](size_t task)
+	{	for(size_t k(task*DeliveryTask);k<spikes_.size() && k<(task+1)*DeliveryTask;++k)
+		{	double amplitude(getAmplitude(spikes_[k]));
+			for(unsigned int delay(getMinDelay());delay<=getMaxDelay();++delay)
+			{	View<unsigned int const> targets(getTargets(spikes_[k], delay));
+				for(size_t j(0);j<targets.size();++j)
+				{	neurons_[targets[j]]->receiveShared(clock_time_+delay, amplitude);
+				}
+			}
+		}
+	});
+}
+
+void Network::transmit(unsigned int const& neuron)
+{	
+	/*	Each neuron linked will receive the spike after the delay of its synapse, in the corresponding slot
+	 * 	of their individual buffers. The targets of a delay are contiguous and written in the same slot.	*/
+	double amplitude(getAmplitude(neuron));
+	unsigned int min_delay(getMinDelay()), max_delay(getMaxDelay());
+	for(unsigned int delay(min_delay);delay<=max_delay;++delay)
+	{	View<unsigned int const> targets(getTargets(neuron, delay));
+		for(size_t j(0);j<targets.size();++j)
+		{	deliver(targets[j], amplitude, clock_time_+delay);
+		}
 	}
+}
+
+void Network::recordSpike(unsigned int const& neuron, double const& potential)
+{	
+	/*	The output keeps the time step of the spike, the neuron having spiked and its membrane potential.	*/
+	output_->writeSpike(clock_time_, neuron, potential);
 	
-	++index_write_;
-	if(index_write_>delay_steps)
-	{	index_write_=0;
+	/*	The spike is recorded by the online statistics.	*/
+	if(statistics_!=nullptr)
+	{	statistics_->addSpike(neuron, clock_time_);
 	}
+}
+
+bool Network::recordStep(unsigned int const& number_spikes)
+{	
+	/*	The output keeps track of the number of spikes occurring at each time step.	*/
+	output_->writeStep(clock_time_, number_spikes);
 	
+	if(spectrum_!=nullptr)
+	{	spectrum_->addStep(number_spikes);
+	}
+	
+	/*	Each complete bin of the statistics is given to the classifier, which may stop the simulation.	*/
+	if(statistics_!=nullptr && statistics_->endStep() && classifier_!=nullptr)
+	{	double peak(spectrum_!=nullptr ? spectrum_->getDominantFrequency() : 0.0);
+		return classifier_->update(*statistics_, peak);
+	}
+	return false;
 }
 
+void Network::synchronize(size_t const& begin, size_t const& end)
+{	for(size_t i(begin);i<end;++i)
+	{	neurons_[i]->advanceTo(clock_time_);
+	}
+}
 
 
+void Network::deliver(unsigned int const& target, double const& amplitude, unsigned int const& arrival)
+{	
+	/*	If the target is parked...	*/
+	if(wake_time_[target]>clock_time_)
+	{	
+		if(neurons_[target]->getRefractoryTime()>0)
+		{	/*	...because it is refractory, the spike is lost if it arrives before the end of the
+			 * 	refractory period, as the neuron would reset its buffer without reading it.	*/
+			if(arrival<wake_time_[target])
+			{	return;
+			}
+		} else if(arrival<wake_time_[target])
+		{	/*	...because it is quiescent, it has to be woken up when the spike arrives.	*/
+			wake_time_[target]=arrival;
+		}
+	}
+	
+	if(last_arrival_[target]<arrival)
+	{	last_arrival_[target]=arrival;
+	}
+	/*	The buffer keeps the spikes of the next getBufferDepth()-1 time steps.	*/
+	assert(arrival>=clock_time_ && arrival<clock_time_+neurons_[target]->getBufferDepth());
+	neurons_[target]->receive(arrival, amplitude);
+}
+
+void Network::park(unsigned int const& neuron)
+{	
+	Neuron* parked(neurons_[neuron]);
+	
+	/*	The neuron has been updated for the present time step.	*/
+	unsigned int next(clock_time_+1);
+	
+	if(parked->getRefractoryTime()>0)
+	{	/*	A refractory neuron wakes up at the end of its refractory period. The spikes already in its
+		 * 	buffer which arrive before are erased, since it would not have read them.	*/
+		unsigned int wake(next+parked->getRefractoryTime());
+		for(unsigned int step(next);step<wake && step<clock_time_+parked->getBufferDepth();++step)
+		{	parked->setBuffer(step, 0.0);
+		}
+		wake_time_[neuron]=wake;
+		
+	} else if(!hasRandomSpikes() && parked->getInput()==0.0 && parked->getMembranePotential()<=MembraneThreshold
+				&& last_arrival_[neuron]<next)
+	{	/*	Without input, noise nor spikes to come, the membrane potential can only relax towards 0
+		 * 	and the neuron cannot spike: it is parked until a spike is delivered to it.	*/
+		wake_time_[neuron]=numeric_limits<unsigned int>::max();
+	}
+}
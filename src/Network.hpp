@@ -3,20 +3,84 @@
 #include <iostream>
 #include <vector>
 #include "Neuron.hpp"
+#include "SpikeStatistics.hpp"
+#include "RegimeClassifier.hpp"
+#include "SpectralEstimator.hpp"
+#include "Arena.hpp"
+#include "TaskScheduler.hpp"
+#include "CounterRandom.hpp"
+#include "Connectivity.hpp"
+#include "SpikeSource.hpp"
+#include "StimulusSchedule.hpp"
+#include "OutputSink.hpp"
 #include <random>
 #include <fstream>
+#include <memory>
 
 using namespace std;
 
-typedef vector<vector<unsigned int>> matrix; /**<	Useful typedef for better comprehension of further code.	*/
+//! PotentialView class
+/*!	Read-only range on the membrane potentials of neurons, read from the neurons themselves while iterating. */
+class PotentialView
+{
+	private:
+	View<Neuron* const> neurons_;	/**<	Neurons whose potentials are read.	*/
+	
+	public:
+	//! Iterator on the membrane potentials
+	class const_iterator
+	{	
+		private:
+		Neuron* const* neuron_;	/**<	Present neuron.	*/
+		
+		public:
+		const_iterator(Neuron* const* neuron) : neuron_(neuron) {}
+		double operator*() const { return (*neuron_)->getMembranePotential(); }
+		const_iterator& operator++() { ++neuron_; return *this; }
+		bool operator==(const_iterator const& other) const { return neuron_==other.neuron_; }
+		bool operator!=(const_iterator const& other) const { return neuron_!=other.neuron_; }
+	};
+	
+	//! Constructor
+	/*!	@param neurons: Neurons whose potentials are read.	*/
+	PotentialView(View<Neuron* const> const& neurons) : neurons_(neurons) {}
+	
+	//! Gets the number of potentials
+	size_t size() const { return neurons_.size(); }
+	//! Gets the membrane potential of a neuron
+	double operator[](size_t const& idx) const { return neurons_[idx]->getMembranePotential(); }
+	//! Gets an iterator on the first potential
+	const_iterator begin() const { return const_iterator(neurons_.begin()); }
+	//! Gets an iterator past the last potential
+	const_iterator end() const { return const_iterator(neurons_.end()); }
+};
+
+//! Initial potentials of the neurons of a network
+/*!	Neurons all starting at rest are synchronised by their first spikes, and the network goes through a
+ * 	synchronous burst before reaching its regime. Drawing the initial potentials shortens this transient.	*/
+enum InitialPotential
+{	ZeroPotentials,			/**<	All the neurons start at rest.																*/
+	UniformPotentials,		/**<	Potentials drawn uniformly between the reset potential and the threshold.					*/
+	StationaryPotentials	/**<	Potentials and refractory times drawn from the stationary state predicted by MeanField.	*/
+};
+
+//! External input of the neurons of a network
+/*!	Each neuron receives the spikes of CE external neurons firing at ExternalFrequency, a Poisson number of
+ * 	spikes of mean ExternalFrequency*dt per time step. In the diffusion approximation of the paper, valid
+ * 	for many small inputs, this number is replaced by a gaussian current of the same mean and variance.	*/
+enum ExternalInput
+{	PoissonInput,				/**<	Poisson number of spikes of amplitude J.											*/
+	GaussianInput,				/**<	Gaussian current of the same mean and variance, independent between time steps.	*/
+	OrnsteinUhlenbeckInput		/**<	Gaussian current of the same mean and variance, filtered with a correlation time.	*/
+};
 
 //! Network class
-		/*!	A network is caracterized by the neurons it contains, its global time,  the indexes to_read_ and 
-		 * 	to_write_ in each neuron's buffer as well as a matrix of indexes of neurons linked.
+		/*!	A network is caracterized by the neurons it contains, its global time and a matrix of indexes
+		 * 	of neurons linked.
 		 * 
-		 * This configuration of indexes will make both indexes evolve together, therefore making
-		 * 	sure that the delay between them is always of delay_steps. Indeed, a neuron will receive its spike at 
-		 * 	index_write_, which is delay_steps_ later than index_read_.		
+		 * 	The buffers of the neurons are indexed by the global time: a neuron reads the slot of the present
+		 * 	time step, and a spike is written in the slot of the time step at which it arrives, delay_steps
+		 * 	later or the delay of its synapse. Nothing has to be advanced at each time step.		
 		 * 
 		 * 	The network is optimized in order to choose whether the network will contain all 12500 neurons,
 		 * 	as well as whether background noise is wanted or not. */
@@ -27,34 +91,87 @@ class Network
 		 
 	bool all_;					/**< 	Set to true if all 12500 neurons are part of the network.									*/
 	bool random_wanted_;		/**<	Set to true if we want to include random spikes as background noise or not.					*/
-	vector<Neuron*> neurons_;	/**< 	Vector of pointers on the neurons containted in the network.								*/
+	Arena arena_;				/**<	Arena owning the memory of the neurons of the network, in blocks of 2 MB backed by huge
+											pages for all 12500 neurons, or of SmallBlock bytes otherwise. The spike histories, the
+											buffers and the links of each neuron stay on the heap.										*/
+	vector<Neuron*> neurons_;	/**< 	Vector of pointers on the neurons containted in the network, constructed in the arena.		*/
 	unsigned int clock_time_;	/**<	 Global time of network.																	*/
-	unsigned int index_read_;	/**<	(index_read_): Index when reading the neuron's buffer.										*/
-	unsigned int index_write_;	/**<	(index_write_): Index when writing spikes (index_read+delay_steps).							*/
-	matrix links_;				/**<	(links_ ):Matrix of links between neurons. 													*/
+	InitialPotential initial_;	/**<	Strategy drawing the initial potentials of the neurons.										*/
+	
+	/**!	Links and delays of the synapses of a network of all 12500 neurons: the row of links of each neuron is sorted
+	 * 		by delay, so that the targets of a delay are contiguous and delivered in the same slot of the buffers. The
+	 * 		connectivity is shared by the networks forked from the same network, and copied before being modified.	*/
+	 
+	shared_ptr<Connectivity> connectivity_;	/**<	Connectivity of the network, nullptr without all 12500 neurons.		*/
+	
+	/**!	Active set of the network: a neuron is only updated at the time steps where something can happen to it.
+	 * 		Refractory neurons are parked until the end of their refractory period, and in simulations without
+	 * 		background noise, neurons without input nor spikes in their buffer are parked until a spike arrives.	*/
+	 
+	vector<unsigned int> wake_time_;	/**<	Time step at which each neuron has to be updated again.							*/
+	vector<unsigned int> last_arrival_;	/**<	Last time step at which a spike is due in the buffer of each neuron.			*/
+	vector<unsigned int> spikes_;		/**<	Neurons which spiked during the present time step.								*/
 	
 	/**!	The following variables are useful to generate random integers, wanted when initializing connections 
-	 * 		between neurons and generating random spikes.	*/
+	 * 		between neurons and generating random spikes. The numbers of a neuron only depend on the seed and on
+	 * 		the connection or the time step they are drawn for, whatever the order in which they are drawn.	*/
 	 
-	mt19937 generator;			/**<					Mersenne twister engine. 													*/
-	poisson_distribution<unsigned int> distribution; 					/**<	(distribution):	Poisson distribution 				*/
+	CounterRandom random_;		/**<	Counter-based generator of the links, the delays and the random spikes.				*/
+	PoissonInverse poisson_;	/**<	Poisson distribution of the number of random spikes received during a time step.	*/
+	ExternalInput input_;		/**<	Kind of external input of the neurons.												*/
+	double decay_;				/**<	Decay of the Ornstein-Uhlenbeck noise during a time step.							*/
+	vector<double> noise_;		/**<	Ornstein-Uhlenbeck noise of each neuron, of mean 0 and standard deviation 1.		*/
+	vector<unsigned int> noise_time_;	/**<	Time step of the last draw of the noise of each neuron.					*/
+	SpikeSource* source_;				/**<	Source of external spikes driving the neurons, if wanted (not owned).	*/
+	StimulusSchedule* stimuli_;			/**<	Stimuli applied to the neurons, if wanted (not owned).					*/
+	vector<double> base_inputs_;		/**<	Inputs of the neurons without the currents of the stimuli.				*/
+	
+	SpikeStatistics* statistics_;	/**<	Online statistics updated during the simulation, if wanted (not owned).				*/
+	RegimeClassifier* classifier_;	/**<	Classifier stopping the simulation once the regime is known, if wanted (not owned).	*/
+	SpectralEstimator* spectrum_;	/**<	Spectrum of the population activity estimated during the simulation (not owned).		*/
 	
-	/**!	The following variables enables us to have access to these files in the update method: they are opened
-	 * 		in the constructor and closed in the destructor.	*/
+	/**!	With a task scheduler, each time step is split in tasks updating ranges of IntegrationTask neurons,
+	 * 		then in tasks delivering DeliveryTask spikes, executed by its threads with work stealing.	*/
 	 
-	ofstream file; 				/**<	File keeping track of the number of spikes per time step.									*/
-	ofstream f;					/**<	File keeping track of the ids of neurons spiking at a time.									*/
+	TaskScheduler* scheduler_;					/**<	Scheduler executing the tasks, nullptr to simulate in this thread (not owned).	*/
+	vector<vector<unsigned int>> task_spikes_;	/**<	Neurons which spiked in the range of each task.									*/
+	
+	shared_ptr<OutputSink> output_;	/**<	Output receiving the spikes and the number of spikes per time step.	*/
 	
 	public:
+	static constexpr size_t IntegrationTask=256;	/**<	Number of neurons updated by a task.	*/
+	static constexpr size_t DeliveryTask=16;		/**<	Number of spikes delivered by a task.	*/
+	static constexpr size_t SmallBlock=size_t(1)<<16;	/**<	Size of the blocks of the arena of a network built neuron by neuron.	*/
+	
 	//! Constructor
-	/*! By default, the vector of neurons it contains has a size of 0, the simulation time is set to 0,
-	 * 	the index to read from the buffer starts at index 0, whereas the index to write starts at 
-	 * 	index delay_steps.*/
-	Network(	bool all, bool random, vector<Neuron*> new_neur=vector<Neuron*>(0), unsigned int clock=0,
-				unsigned int read=0, unsigned int write=delay_steps);
+	/*! By default, the network contains no neurons and the simulation time is set to 0. The initial potentials
+	 * 	of all 12500 neurons are drawn with the given strategy, and drawn again by setSeed. The output is
+	 * 	written in the files spikes.txt and jupyterplot.txt of the current directory.*/
+	Network(	bool all, bool random, unsigned int clock=0, InitialPotential initial=ZeroPotentials);
+	
+	//! Constructor with an output
+	/*! Same as the constructor writing files, with the output chosen, for instance a NullSink in tests, a
+	 * 	MemorySink to read the spikes back, or an MmapSink for long simulations.
+	 * 	@param output: Output of the network, which may be shared with other objects.*/
+	Network(	bool all, bool random, shared_ptr<OutputSink> output, unsigned int clock=0,
+				InitialPotential initial=ZeroPotentials);
+	
+	//! Constructor forking a network
+	/*!	The child continues the simulation of the parent from its present state, with its own neurons, their
+	 * 	histories and buffers being copied, and the connectivity of the parent, which is shared until one of
+	 * 	them modifies it. The statistics, the classifier, the spectral estimator, the scheduler, the
+	 * 	spike source and the stimuli of the parent are not kept.
+	 * 	@param parent: Network forked, for instance after its transient.
+	 * 	@param seed: Seed of the random spikes of the child.
+	 * 	@param output: Output of the child, discarded by default, since the files of the parent must not be
+	 * 	written by its children.	*/
+	Network(Network const& parent, unsigned int seed, shared_ptr<OutputSink> output=make_shared<NullSink>());
+	
+	Network(Network const&) = delete;
+	Network& operator=(Network const&) = delete;
 	
 	//! Destructor
-	/*!	Clears the vector of neurons in the network by setting them to nullptr and deleting them.	*/
+	/*!	Destroys the neurons in the network and releases the arena.	*/
 	~Network();
 
 /***************************************************/
@@ -63,28 +180,142 @@ class Network
 	/*!	@return : Simulation time, as a dt step.	*/
 	unsigned int getClockTime() const;
 	//! Gets the neurons in the network
-	/*!	@return Vector of pointers on neurons.	*/
-	vector<Neuron*> getNeurons() const;
+	/*!	@return View on the pointers on neurons, valid until neurons are added or removed.	*/
+	View<Neuron* const> getNeurons() const;
+	//! Gets the membrane potentials of the neurons in the network
+	/*!	@return View on the potentials, valid until neurons are added or removed.	*/
+	PotentialView getPotentials() const;
 	//! Gets the matrix of links in the network
-	/*! @return Matrix of links	*/
+	/*! @return View on the matrix of links, with no rows if the links have not been initialized.	*/
 	matrix getLinks() const;
+	//! Gets the neurons receiving the spikes of a neuron (only when all neurons are in the network)
+	/*!	@param neuron: Index of the neuron.
+	 * 	@return View on the indexes of the neurons linked.	*/
+	View<unsigned int const> getLinkRow(unsigned int const& neuron) const;
+	//! Gets the shortest delay of the synapses
+	/*!	@return Delay in time steps, delay_steps unless delays have been drawn.	*/
+	unsigned int getMinDelay() const;
+	//! Gets the longest delay of the synapses
+	/*!	@return Delay in time steps, delay_steps unless delays have been drawn.	*/
+	unsigned int getMaxDelay() const;
+	//! Gets the connectivity of the network
+	/*!	@return Pointer on the connectivity, shared with the networks forked from the same network, nullptr
+	 * 	without all 12500 neurons.	*/
+	shared_ptr<Connectivity const> getConnectivity() const;
+	//! Gets the online statistics of the network
+	/*!	@return Pointer on the statistics, nullptr if none are computed.	*/
+	SpikeStatistics* getStatistics() const;
+	//! Gets the regime classifier of the network
+	/*!	@return Pointer on the classifier, nullptr if there is none.	*/
+	RegimeClassifier* getClassifier() const;
+	//! Gets the spectral estimator of the network
+	/*!	@return Pointer on the estimator, nullptr if there is none.	*/
+	SpectralEstimator* getSpectralEstimator() const;
+	//! Gets the arena of the network
+	/*!	@return Arena owning the neurons, with the pages backing them.	*/
+	Arena const& getArena() const;
+	//! Gets the output of the network
+	/*!	@return Output receiving the spikes, shared by whoever holds it.	*/
+	OutputSink& getOutput() const;
+	//! Gets the task scheduler of the network
+	/*!	@return Pointer on the scheduler, nullptr if the network is simulated in the calling thread.	*/
+	TaskScheduler* getScheduler() const;
+	//! Gets whether the neurons receive random spikes as background noise
+	/*!	@return bool: Whether random spikes are wanted and no spike source replaces them.	*/
+	bool hasRandomSpikes() const;
+	//! Gets the seed of the random generator
+	/*!	@return Seed, drawn from a random device unless set with setSeed.	*/
+	unsigned int getSeed() const;
+	//! Gets the kind of external input of the neurons
+	ExternalInput getExternalInput() const;
+	//! Gets the source of external spikes driving the neurons
+	/*!	@return Pointer on the source, nullptr if there is none.	*/
+	SpikeSource* getSpikeSource() const;
+	//! Gets the stimuli applied to the neurons
+	/*!	@return Pointer on the schedule, nullptr if there is none.	*/
+	StimulusSchedule* getStimuli() const;
 /***************************************************/
 	/*	Setters	*/
 	//!	Sets the clock time
 	/*!	@param	new_time: New value for the clock time. */
 	void setClockTime(unsigned int const& new_time);
 	//!	Sets the neurons in the network
-	/*!	@param	new_neurons: New vector of neurons wanting to be part of the network. */
-	void setNeurons(vector<Neuron*> const& new_neurons);
+	/*!	The neurons in the network are destroyed and replaced by copies of the new ones.
+	 * 	@param	new_neurons: New vector of neurons wanting to be part of the network. */
+	void setNeurons(vector<Neuron> const& new_neurons);
+	//!	Sets the number of spikes kept in the history of each neuron
+	/*!	@param	capacity: Number of last spikes kept, 0 to keep them all. */
+	void setHistoryCapacity(size_t const& capacity);
+	//!	Sets the online statistics updated during the simulation
+	/*!	The statistics are not owned by the network, and must have been created for its number of neurons.
+	 * 	@param	statistics: Pointer on the statistics, nullptr to stop computing them. */
+	void setStatistics(SpikeStatistics* statistics);
+	//!	Sets the regime classifier
+	/*!	The classifier is fed with the online statistics each time a bin is completed, and the simulation
+	 * 	stops as soon as the classifier has decided the regime. It is not owned by the network, and is only
+	 * 	used if statistics are computed, which it resets once the initial transient is over.
+	 * 	@param	classifier: Pointer on the classifier, nullptr to simulate until the end time. */
+	void setClassifier(RegimeClassifier* classifier);
+	//!	Sets the spectral estimator
+	/*!	The estimator receives the number of spikes of each time step, and its dominant frequency is given
+	 * 	to the regime classifier. It is not owned by the network.
+	 * 	@param	spectrum: Pointer on the estimator, nullptr to stop estimating the spectrum. */
+	void setSpectralEstimator(SpectralEstimator* spectrum);
+	//!	Sets whether the memory of the network is backed by huge pages
+	/*!	Huge pages are requested by default, since the delivery of spikes reads the links and the buffers of
+	 * 	random neurons. The choice applies to the memory allocated afterwards, when neurons are set.
+	 * 	@param	huge_pages: Whether huge pages are requested. */
+	void setHugePages(bool const& huge_pages);
+	//!	Sets the seed of the random generator
+	/*!	The links of a network of all 12500 neurons are drawn again with the new seed, so that two networks
+	 * 	with the same seed have the same links and receive the same random spikes, whatever the number of
+	 * 	threads or processes simulating them. The initial potentials are drawn again too, unless they are zero.
+	 * 	@param	seed: Seed of the generator. */
+	void setSeed(unsigned int const& seed);
+	//!	Sets the task scheduler
+	/*!	The neurons are updated and the spikes delivered by the threads of the scheduler. The spike trains are
+	 * 	the same as without threads, except for the rounding of the sums of spikes of different amplitudes
+	 * 	arriving in the same buffer slot, which are added in any order. The scheduler is not owned by the network.
+	 * 	@param	scheduler: Pointer on the scheduler, nullptr to simulate in the calling thread. */
+	void setScheduler(TaskScheduler* scheduler);
+	//!	Sets the delays of the synapses (only when all neurons are in the network)
+	/*!	The delay of each synapse is drawn uniformly between min and max, and the links of each neuron are
+	 * 	sorted by delay. The buffers of the neurons are emptied and made deep enough for the longest delay,
+	 * 	so the delays are set before simulating. They are drawn again with the links by setSeed.
+	 * 	@param	min: Shortest delay in time steps, at least 1.
+	 * 	@param	max: Longest delay in time steps. */
+	void setDelays(unsigned int const& min, unsigned int const& max);
+	//!	Sets the kind of external input of the neurons (only when random spikes are wanted)
+	/*!	The gaussian inputs are drawn from the seed of the network like the random spikes, so the spike trains
+	 * 	are still the same whatever the number of threads or processes simulating the network.
+	 * 	@param	input: Kind of external input.
+	 * 	@param	correlation_time: Correlation time of the Ornstein-Uhlenbeck noise in ms. */
+	void setExternalInput(ExternalInput const& input, double const& correlation_time=1.0);
+	//!	Sets the source of external spikes driving the neurons
+	/*!	The spikes of the source, such as an ExternalPopulation or a SpikeReplay, are delivered to the neurons
+	 * 	during the time step at which they occur, and replace the random spikes while the source is set. Since
+	 * 	the neurons without input are then parked until a spike arrives, a time step only costs the external
+	 * 	spikes delivered. The source starts at the present time step, and is not owned by the network.
+	 * 	@param	source: Pointer on the source, whose projection targets the neurons, nullptr to remove it. */
+	void setSpikeSource(SpikeSource* source);
+	//!	Sets the stimuli applied to the neurons
+	/*!	The currents of the stimuli are added to the inputs of the neurons at this time, which they change
+	 * 	during the simulation at the time steps of the timeline of the schedule. The timeline starts at
+	 * 	time step 0, the stimuli of the past time steps being applied at once. An input set between two
+	 * 	simulations is the present input of the neuron, the later changes of its stimuli being added to it.
+	 * 	The schedule is not owned by the network, and removing it puts the inputs back.
+	 * 	@param	stimuli: Pointer on the schedule, nullptr to remove it. */
+	void setStimuli(StimulusSchedule* stimuli);
 
 /***************************************************/
-	//!A public function taking a Neuron pointer as parameter
-	/**! Adds a neuron to the list of neurons in the network.
-	 * @param neuron_to_add: Pointer on a neuron	*/
-	 void addNeuron(Neuron* neuron_to_add);
+	//!A public function taking a Neuron as parameter
+	/**! Adds a copy of a neuron, constructed in the arena of the network, to the list of neurons in the network.
+	 * @param neuron_to_add: Neuron to copy.
+	 * @return Pointer on the neuron in the network. */
+	 Neuron* addNeuron(Neuron const& neuron_to_add);
 	 
 	//!A public function
-	/*!	Clears the vector of all neurons in the network.*/
+	/*!	Destroys all neurons and links in the network, and releases the arena in one go.*/
 	void clearNeurons();
 	
 	//!A public function taking vector of pointers on neurons as a parameter
@@ -97,28 +328,131 @@ class Network
 	/*! Initializes the matrix of connections in the network.	*/
 	void initializeConnections();
 	
-	//!A public function taking two unsigned int as parameters.
-	/*! Generates a random integer between min and max.
-	 * 	@param min: Minimum limit of value wanting to be generated.
-	 * 	@param max: Maximum limit of value wanting to be generated.
-	 * 	@return unsigned int: Random integer between min and max.	*/
-	unsigned int uniform(unsigned int const& min, unsigned int const& max);
+	//!A public function taking a strategy as parameter
+	/*! Draws the membrane potentials of the neurons from the seed of the network, emptying their refractory periods.
+	 * 	With the stationary strategy, the neurons are refractory with the probability predicted by MeanField for the
+	 * 	parameters of Utility/Constants.hpp, and their potentials follow the stationary distribution otherwise.
+	 * 	@param initial: Strategy drawing the potentials.	*/
+	void initializePotentials(InitialPotential const& initial);
 	
-	//!A public function
+	//!A public function taking an unsigned int as parameter
 	/*! Gives a certain number of spikes generated randomly from external neurons, with a 
 	 * 	poisson distribution.
+	 * 	@param neuron: Index of the neuron receiving the spikes during the present time step.
 	 * 	@return unsigned integer: Number of spikes.	*/
-	unsigned int randomSpikes();
+	unsigned int randomSpikes(unsigned int const& neuron) const;
+	
+	//!A public function taking an unsigned int as parameter
+	/*! Gives the amplitude received from the external neurons, with the kind of external input of the network.
+	 * 	The Ornstein-Uhlenbeck noise of a neuron which has not been updated for several time steps, for instance
+	 * 	during its refractory period, is drawn from its exact distribution after these time steps.
+	 * 	@param neuron: Index of the neuron receiving the input during the present time step.
+	 * 	@return Real: Amplitude in mV.	*/
+	Real externalInput(unsigned int const& neuron);
 	
 	
 	//!A public function taking a double argument
 	/*!	Method updating all neurons in the network, passing on the spike signal in case of spike.	
+	 * 	The simulation stops earlier if a regime classifier has decided the regime of the network.
 	 * 	@param endtime: Time at which simulation ends.*/
 	void update(double const& endtime);
 	
+	//!A public function taking a range of neurons as parameter
+	/*!	Delivers the spikes of the source of external spikes during the present time step.
+	 * 	@param begin: First neuron receiving the spikes.
+	 * 	@param end: Neuron after the last one receiving the spikes.	*/
+	void fireExternal(size_t const& begin, size_t const& end);
+	
+	//!A public function taking a range of neurons as parameter
+	/*!	Changes the inputs of the neurons of the range whose stimuli change during the present time step.
+	 * 	A parked neuron is brought up to the present time step with its previous input, and woken up unless
+	 * 	it is refractory.
+	 * 	@param begin: First neuron whose input may change.
+	 * 	@param end: Neuron after the last one whose input may change.	*/
+	void applyStimuli(size_t const& begin, size_t const& end);
+	
 	//!A public function
-	/*!	Method updating the indexes to read and to write. s*/
-	void updateBuffer();
+	/*!	Reads the inputs of the neurons without the currents of the stimuli, so that an input set between
+	 * 	two simulations is the one the stimuli are added to.	*/
+	void readInputs();
+	
+	//!A public function taking an unsigned int as parameter
+	/*!	@param neuron: Index of a neuron.
+	 * 	@return View on the indexes of the neurons receiving its spikes.	*/
+	View<unsigned int const> getTargets(unsigned int const& neuron) const;
+	
+	//!A public function taking two unsigned int as parameters
+	/*!	@param neuron: Index of a neuron.
+	 * 	@param delay: Delay in time steps.
+	 * 	@return View on the indexes of the neurons receiving its spikes with this delay.	*/
+	View<unsigned int const> getTargets(unsigned int const& neuron, unsigned int const& delay) const;
+	
+	//!A public function taking an unsigned int as parameter
+	/*!	@param neuron: Index of a neuron.
+	 * 	@return double: Amplitude of the spikes it transmits.	*/
+	double getAmplitude(unsigned int const& neuron) const;
+	
+	private:
+	
+	/*!	The process engine simulates ranges of neurons of the network in worker processes.	*/
+	friend class ProcessEngine;
+	
+	//!A private function taking a range of neurons as parameter
+	/*!	Puts the neurons of a range in the active set at the beginning of a simulation.
+	 * 	@param begin: First neuron of the range.
+	 * 	@param end: Neuron after the last one of the range.	*/
+	void activate(size_t const& begin, size_t const& end);
+	
+	//!A private function taking a range of neurons and a vector as parameters
+	/*!	Updates the active neurons of a range for the present time step.
+	 * 	@param begin: First neuron of the range.
+	 * 	@param end: Neuron after the last one of the range.
+	 * 	@param spikes: Vector to which the indexes of the neurons which spiked are added.	*/
+	void integrate(size_t const& begin, size_t const& end, vector<unsigned int>& spikes);
+	
+	//!A private function
+	/*!	Updates all the neurons with the tasks of the scheduler, and keeps the ones which spiked in spikes_.	*/
+	void integrateShared();
+	
+	//!A private function
+	/*!	Delivers the spikes of spikes_ with the tasks of the scheduler.	*/
+	void transmitShared();
+	
+	//!A private function taking an unsigned int as parameter
+	/*!	Transmits the spike of a neuron, at the present time step, to all the neurons it is linked to.
+	 * 	@param neuron: Index of the neuron which spiked.	*/
+	void transmit(unsigned int const& neuron);
+	
+	//!A private function taking an unsigned int, a double and an unsigned int as parameters
+	/*!	Transmits a spike to a neuron of the network. Spikes arriving while the neuron is refractory are
+	 * 	dropped, and a neuron parked because it was quiescent is woken up at the arrival of the spike.
+	 * 	@param target: Index of the neuron receiving the spike.
+	 * 	@param amplitude: Amplitude transmitted.
+	 * 	@param arrival: Time step at which the spike will be read, at most the longest delay after the present one.	*/
+	void deliver(unsigned int const& target, double const& amplitude, unsigned int const& arrival);
+	
+	//!A private function taking an unsigned int and a double as parameters
+	/*!	Records the spike of a neuron at the present time step in the files and the statistics.
+	 * 	@param neuron: Index of the neuron which spiked.
+	 * 	@param potential: Membrane potential of the neuron when it spiked.	*/
+	void recordSpike(unsigned int const& neuron, double const& potential);
+	
+	//!A private function taking an unsigned int as parameter
+	/*!	Records the number of spikes of the present time step in the files, the spectrum and the statistics.
+	 * 	@param number_spikes: Number of spikes.
+	 * 	@return bool: Whether the classifier has decided to stop the simulation.	*/
+	bool recordStep(unsigned int const& number_spikes);
+	
+	//!A private function taking a range of neurons as parameter
+	/*!	Brings the parked neurons of a range up to the clock time of the network.
+	 * 	@param begin: First neuron of the range.
+	 * 	@param end: Neuron after the last one of the range.	*/
+	void synchronize(size_t const& begin, size_t const& end);
+	
+	//!A private function taking an unsigned int as parameter
+	/*!	Removes a neuron which has just been updated from the active set if it is refractory or quiescent.
+	 * 	@param neuron: Index of the neuron.	*/
+	void park(unsigned int const& neuron);
 	
 };
 #endif
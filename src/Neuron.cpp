@@ -8,9 +8,10 @@ using namespace std;
 
 Neuron::Neuron(	bool excitatory, double input, vector<unsigned int> linked, vector<double> time, 
 				double potential, unsigned int present, vector<double> b, unsigned int refract)
-	: 	excitatory_(excitatory), input_(input), linked_neurons_(linked),  time_(time), membrane_potential_(potential),
+	: 	excitatory_(excitatory), input_(input), linked_neurons_(linked), membrane_potential_(potential),
 		present_time_(present), buffer_(b), refractory_time_(refract)
-{}
+{	setTime(time);
+}
 
 Neuron::~Neuron()
 {}
@@ -22,6 +23,10 @@ double Neuron::getBuffer(int const& idx) const
 	return buffer_[idx];
 }
 
+unsigned int Neuron::getBufferDepth() const
+{	return buffer_.getDepth();
+}
+
 bool Neuron::getExcitatory() const
 {
 	return excitatory_;
@@ -31,8 +36,8 @@ double Neuron::getInput() const
 {	return input_;
 }
 
-vector<unsigned int> Neuron::getLinkedNeurons() const
-{	return linked_neurons_;
+View<unsigned int const> Neuron::getLinkedNeurons() const
+{	return View<unsigned int const>(linked_neurons_.data(), linked_neurons_.size());
 }
 
 double Neuron::getMembranePotential() const
@@ -47,7 +52,7 @@ unsigned int Neuron::getRefractoryTime() const
 {	return refractory_time_;
 }
 
-vector<double> Neuron::getTime() const
+SpikeHistory const& Neuron::getTime() const
 {	return time_;
 }
 
@@ -58,6 +63,10 @@ void Neuron::setBuffer(int const& idx, double const& new_value)
 	buffer_[idx]=new_value;
 }
 
+void Neuron::setMaxDelay(unsigned int const& max_delay)
+{	buffer_.reset(max_delay);
+}
+
 void Neuron::setExcitatory(bool const& excit)
 {	excitatory_=excit;
 }
@@ -79,11 +88,45 @@ void Neuron::setRefractoryTime(unsigned int const& new_refract)
 }
 
 void Neuron::setTime(vector<double> const& new_time)
-{	time_=new_time;
+{	/*	The times are converted back to time steps.	*/
+	time_.clear();
+	for(size_t i(0);i<new_time.size();++i)
+	{	time_.add(static_cast<unsigned int>(round(new_time[i]/dt)));
+	}
+}
+
+void Neuron::setHistoryCapacity(size_t const& capacity)
+{	time_.setCapacity(capacity);
 }
 
 /***************************************************/
 
+void Neuron::advanceTo(unsigned int const& time)
+{	/*	Number of time steps the neuron has skipped.	*/
+	unsigned int steps(time>present_time_ ? time-present_time_ : 0);
+	
+	/*	The refractory steps skipped only reset the membrane potential.	*/
+	unsigned int refractory(steps<refractory_time_ ? steps : refractory_time_);
+	if(refractory>0)
+	{	membrane_potential_=MembraneReset;
+		refractory_time_-=refractory;
+		steps-=refractory;
+	}
+	
+	/*	The other steps follow the membrane equation without any spike received, one at a time, so that
+	 * 	the potential does not depend on how long the neuron has been parked. Once rounded, the potential
+	 * 	relaxing towards input*Resistance stops changing, and the remaining steps leave it as it is.	*/
+	for(unsigned int i(0);i<steps;++i)
+	{	Real potential(MembranePotentialEquation(0.0));
+		if(potential==membrane_potential_)
+		{	break;
+		}
+		membrane_potential_=potential;
+	}
+	
+	present_time_+=refractory+steps;
+}
+
 void Neuron::addLink(unsigned int const& neuron)
 {	/*	Adds the index of a neuron to the list of neurons linked.	*/
 	linked_neurons_.push_back(neuron);
@@ -91,15 +134,15 @@ void Neuron::addLink(unsigned int const& neuron)
 
 void Neuron::addTimeValue(int const& new_time_value)
 {	/*	Adds the time at which a spike occured.	*/
-	time_.push_back(new_time_value*dt);
+	time_.add(new_time_value);
 }
 
 double Neuron::MembranePotentialEquation(double const& amplitude) const
 {	
 	
 	/*	Equation based on the differential equation for the evolution of the neuron's membrane
-	 * 	potential. */
-	return (membrane_potential_*C)+(input_*D)+(amplitude);
+	 * 	potential, computed in the precision of the membrane potential. */
+	return (membrane_potential_*Real(C))+(input_*Real(D))+Real(amplitude);
 }
 
 void Neuron::receive(unsigned int const& to_write, double const& amplitude)
@@ -107,6 +150,18 @@ void Neuron::receive(unsigned int const& to_write, double const& amplitude)
 	/*	The spike is saved at an index of to_write in the buffer. */
 	buffer_[to_write]+=amplitude;
 }
+
+void Neuron::receiveShared(unsigned int const& to_write, double const& amplitude)
+{	
+	/*	The sum is written only if no other thread has modified the value in the meantime.	*/
+	Accumulator* slot(&buffer_[to_write]);
+	Accumulator expected;
+	__atomic_load(slot, &expected, __ATOMIC_RELAXED);
+	Accumulator desired(expected+amplitude);
+	while(!__atomic_compare_exchange(slot, &expected, &desired, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+	{	desired=expected+amplitude;
+	}
+}
 void Neuron::showTimeValues() const
 {	/*	Shows the value of the times at which each neuron spiked in the terminal.	*/	
 	if(!time_.empty()){
@@ -115,8 +170,8 @@ void Neuron::showTimeValues() const
 			cout<<"Spike n°"<<i+1<<"	: "<< time_[i]<<endl;
 			
 		}
-		cout<<"Total of "<<time_.size();
-			if(time_.size()==1)
+		cout<<"Total of "<<time_.getTotal();
+			if(time_.getTotal()==1)
 			{	cout<<" spike.";
 			} else {
 			cout<<" spikes.";
@@ -128,6 +183,10 @@ void Neuron::showTimeValues() const
 }
 
 bool Neuron::update(unsigned int const& randomspikes, unsigned int const& to_read)
+{	return updateInput(randomspikes*Real(Amplitude), to_read);
+}
+
+bool Neuron::updateInput(Real const& external, unsigned int const& to_read)
 {	/*	Will record if the neuron spikes or not.	*/
 	bool spike(false);
 	/*	If the neuron is still in his refractory period...	*/
@@ -147,7 +206,7 @@ bool Neuron::update(unsigned int const& randomspikes, unsigned int const& to_rea
 		/*	If the neuron isn't refractory and its potential hasn't reached the threshold,
 		 * 	its membrane potential evolves with the differential equation characterizing the
 		 * 	membrane potential evolution over time.	*/
-			membrane_potential_=MembranePotentialEquation(buffer_[to_read]+(randomspikes*Amplitude));
+			membrane_potential_=MembranePotentialEquation(buffer_[to_read]+external);
 	}
 	 
 	 	
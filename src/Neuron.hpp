@@ -4,6 +4,10 @@
 #include <vector>
 #include <math.h>
 #include "Utility/Constants.hpp"
+#include "Utility/Precision.hpp"
+#include "SpikeHistory.hpp"
+#include "RingBuffer.hpp"
+#include "Utility/View.hpp"
 #include <array>
 
 using namespace std;
@@ -21,12 +25,12 @@ class Neuron {
 		 * 	a delay of delay_steps.	*/
 
 		bool excitatory_; 						/**<	Boolean determining if neuron is excitatory or inhibitory.		*/
-		double input_;							/**<	Input received from environment.								*/
+		Real input_;							/**<	Input received from environment.								*/
 		vector<unsigned int> linked_neurons_;	/**<	Neurons linked to this current neuron.							*/
-		vector<double> time_;					/**<	Record of times when a spike occured.							*/
-		double membrane_potential_;				/**<	Membrane potential.												*/
+		SpikeHistory time_;						/**<	Record of time steps when a spike occured.						*/
+		Real membrane_potential_;				/**<	Membrane potential.												*/
 		unsigned int present_time_;				/**<	Local clock of neuron.											*/
-		vector<double> buffer_;					/**<	Ring buffer installing delay principle.							*/
+		RingBuffer buffer_;						/**<	Ring buffer installing delay principle, indexed by time step.	*/
 		unsigned int refractory_time_;			/**<	Refractory time of the neuron.									*/
 
 	
@@ -46,9 +50,12 @@ class Neuron {
 /***************************************************/
 	/*	Getters	*/
 	//! Gets the buffer value at a certain index
-	/*!	@param idx is the index at which we want to find the buffer value.	
+	/*!	@param idx is the index at which we want to find the buffer value, or the time step of this value.	
 	 * 	@return Buffer value at index.	*/
 	double getBuffer(int const& idx) const;
+	//! Gets the number of slots of the buffer
+	/*! @return Depth of the buffer, a power of 2. */
+	unsigned int getBufferDepth() const;
 	//! Getter of whether the neuron is excitatory or not
 	/*! @return Boolean: true if it is excitatory, false if it is inhibitory. */
 	bool getExcitatory() const;
@@ -56,8 +63,8 @@ class Neuron {
 	/*!	@return Input current.	*/
 	double getInput() const;
 	//!	Gets the linked neurons
-	/*!	@return Vector of pointers of the linked neurons.	*/
-	vector<unsigned int> getLinkedNeurons() const;
+	/*!	@return View on the indexes of the linked neurons.	*/
+	View<unsigned int const> getLinkedNeurons() const;
 	//!	Gets the membrane potential
 	/*!	@return Membrane potential.	*/
 	double getMembranePotential() const;
@@ -68,14 +75,18 @@ class Neuron {
 	/*!	@return unsigned int: Refractory time left for the neuron.	*/
 	unsigned int getRefractoryTime() const;
 	//!	Gets the times at which spikes occurred
-	/*!	@return Vector of the times at which the spikes occurred.	*/
-	vector<double> getTime() const;
+	/*!	@return Reference on the history of the spikes, giving their times in milliseconds.	*/
+	SpikeHistory const& getTime() const;
 /***************************************************/	
 	/*	Setters	*/
 	//!	Sets the buffer value at a certain index
-	/*!	@param	idx: Index at which we want to affect buffer.
+	/*!	@param	idx: Index at which we want to affect buffer, or time step of the value.
 	 * 	@param	new_value: New value wanting to be introduced. */
 	void setBuffer(int const& idx, double const& new_value);
+	//!	Sets the largest delay of the spikes received
+	/*!	The buffer is emptied and its depth is the smallest power of 2 above the delay.
+	 * 	@param	max_delay: Largest delay in time steps. */
+	void setMaxDelay(unsigned int const& max_delay);
 	//! Sets excitatory state or inhibitory stat
 	/*!	@param excit: Bool value of excitatory state. */
 	void setExcitatory(bool const& excit);
@@ -92,17 +103,28 @@ class Neuron {
 	/*!	@param new_refract: New refractory time.	*/
 	void setRefractoryTime(unsigned int const& new_refract);
 	//!	Sets the vector of times of spikes
-	/*!	@param	new_time: New vector of times of spikes.	*/
+	/*!	@param	new_time: New vector of times of spikes, in milliseconds.	*/
 	void setTime(vector<double> const& new_time);
+	//!	Sets the number of spikes kept in the history
+	/*!	@param	capacity: Number of last spikes kept, 0 to keep them all.	*/
+	void setHistoryCapacity(size_t const& capacity);
 
 /***************************************************/
+	//!A public function taking an unsigned int as an argument
+	/*!	Brings the local clock of a parked neuron up to a given time, as if it had been updated at
+	 * 	every time step without receiving any spike. The remaining refractory time is consumed in one
+	 * 	go, and the membrane potential then relaxes with the equation without synaptic input, step by step
+	 * 	until it no longer changes. The potential is the one of a neuron updated at every time step.
+	 * 	@param time: Time step the neuron has to reach.	*/
+	void advanceTo(unsigned int const& time);
+
 	//!A public function taking an unsigned int as an argument
 	/*!	Adds the index of a neuron wanting to be linked to its list of linked neurons.
 	 * 	@param neuron: Index of neuron wanting to be added to the linked neurons.		*/
 	void addLink(unsigned int const& neuron);
 	
 	//!A public function taking an integer argument
-	/*!	Adds the time at which a spike occured to the vector.
+	/*!	Adds the time step at which a spike occured to the history.
 	 * 	@param new_time_value: Time at which a spike occured, wanting to be recorded.	*/
 	void addTimeValue(int const& new_time_value);
 	
@@ -114,10 +136,17 @@ class Neuron {
 
 	//!A public function taking an integer argument
 	/*!	Receives signal given by presynaptic neuron, depending on number of connections.
-	 * 	@param to_write: Index of buffer at which the spike is received is recorded.
+	 * 	@param to_write: Time step at which the spike will be read, at most the depth of the buffer - 1 later than
+	 * 	the present one.
 	 * 	@param amplitude: Amplitude received.	*/
 	void receive(unsigned int const& to_write, double const& amplitude);
 	
+	//!A public function taking an integer argument and a double
+	/*!	Receives a signal like receive(), several threads being allowed to write in the same buffer at once.
+	 * 	@param to_write: Time step at which the spike will be read.
+	 * 	@param amplitude: Amplitude received.	*/
+	void receiveShared(unsigned int const& to_write, double const& amplitude);
+	
 	//! A public function
 	/*! Shows the times at which the neuron spiked in the terminal. */
 	void showTimeValues() const;
@@ -125,9 +154,16 @@ class Neuron {
 	//!A public function 
 	/*! Updates the membrane potential, depending on if random spikes are wanted or not.
 	 * 	@param randomspikes: Number of random spikes received.
-	 * 	@param to_read: Indes at which the buffer will be read.
+	 * 	@param to_read: Time step whose slot of the buffer is read.
 	 * 	@return bool: Whether there has been a spike or not. 	*/
 	bool update(unsigned int const& randomspikes, unsigned int const& to_read);
+	
+	//!A public function taking a Real and an unsigned int as arguments
+	/*! Updates the membrane potential like update(), with an external input which is not a number of spikes.
+	 * 	@param external: Amplitude received from outside the network during the time step, in mV.
+	 * 	@param to_read: Time step whose slot of the buffer is read.
+	 * 	@return bool: Whether there has been a spike or not. 	*/
+	bool updateInput(Real const& external, unsigned int const& to_read);
 
 };
 
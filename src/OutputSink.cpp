@@ -0,0 +1,53 @@
+#include "OutputSink.hpp"
+#include <cerrno>
+#include <system_error>
+
+FileSink::FileSink(bool all, string const& steps, string const& spikes)
+	:	all_(all), steps_(steps.c_str()), spikes_(spikes.c_str())
+{	if(steps_.fail() || spikes_.fail())
+	{	throw system_error(errno, generic_category(), "FileSink: cannot create "+(steps_.fail() ? steps : spikes));
+	}
+}
+
+void FileSink::writeSpike(unsigned int const& step, unsigned int const& neuron, double const& potential)
+{	
+	/*	With all 12500 neurons, the file conserves the neuron id and the particular time at which the spike
+	 * 	occurred. Otherwise, it stocks the index of the neuron having spiked and its membrane potential.	*/
+	if(all_)
+	{	spikes_<<step<<" "<<neuron<<endl;
+	} else {
+		spikes_<<neuron+1<<" "<<potential<<endl;
+	}
+}
+
+void FileSink::writeStep(unsigned int const& step, unsigned int const& spikes)
+{	steps_<<step<<" "<<spikes<<endl;
+}
+
+/***************************************************/
+
+MemorySink::MemorySink(size_t capacity)
+{	spikes_.reserve(capacity);
+}
+
+vector<MemorySink::Spike> const& MemorySink::getSpikes() const
+{	return spikes_;
+}
+
+vector<unsigned int> const& MemorySink::getSteps() const
+{	return steps_;
+}
+
+vector<unsigned int> const& MemorySink::getCounts() const
+{	return counts_;
+}
+
+void MemorySink::writeSpike(unsigned int const& step, unsigned int const& neuron, double const& potential)
+{	Spike spike = {step, neuron, potential};
+	spikes_.push_back(spike);
+}
+
+void MemorySink::writeStep(unsigned int const& step, unsigned int const& spikes)
+{	steps_.push_back(step);
+	counts_.push_back(spikes);
+}
@@ -0,0 +1,101 @@
+#ifndef OUTPUTSINK_H
+#define OUTPUTSINK_H
+
+#include <string>
+#include <vector>
+#include <fstream>
+
+using namespace std;
+
+//! OutputSink class
+/*!	Output of a network: the spikes of the neurons, and the number of spikes of each time step. The sink is
+ * 	chosen when the network is constructed, so that tests and parallel simulations do not write files
+ * 	they do not need, nor the same files.	*/
+class OutputSink
+{
+	public:
+	//! Destructor
+	virtual ~OutputSink() {}
+
+	//!A public function taking a time step, a neuron and a potential as parameters
+	/*!	@param step: Time step of the spike.
+	 * 	@param neuron: Index of the neuron which spiked.
+	 * 	@param potential: Membrane potential of the neuron when it spiked.	*/
+	virtual void writeSpike(unsigned int const& step, unsigned int const& neuron, double const& potential) = 0;
+
+	//!A public function taking a time step and a number of spikes as parameters
+	/*!	Called once per time step, after its spikes.
+	 * 	@param step: Time step.
+	 * 	@param spikes: Number of spikes during the time step.	*/
+	virtual void writeStep(unsigned int const& step, unsigned int const& spikes) = 0;
+};
+
+//! FileSink class
+/*!	Writes the output in two text files: the number of spikes of each time step, as "step spikes" lines,
+ * 	and the spikes, as "step neuron" lines for a network of all 12500 neurons, or as "neuron+1 potential"
+ * 	lines otherwise.	*/
+class FileSink : public OutputSink
+{
+	private:
+	bool all_;			/**<	Whether the spikes are written with their time step.	*/
+	ofstream steps_;	/**<	File of the number of spikes of each time step.			*/
+	ofstream spikes_;	/**<	File of the spikes.										*/
+
+	public:
+	//! Constructor
+	/*!	Opens the files, throwing a system_error if one of them cannot be created.
+	 * 	@param all: Whether the network contains all 12500 neurons.
+	 * 	@param steps: Name of the file of the number of spikes of each time step.
+	 * 	@param spikes: Name of the file of the spikes.	*/
+	explicit FileSink(bool all, string const& steps="spikes.txt", string const& spikes="jupyterplot.txt");
+
+	void writeSpike(unsigned int const& step, unsigned int const& neuron, double const& potential) override;
+	void writeStep(unsigned int const& step, unsigned int const& spikes) override;
+};
+
+//! MemorySink class
+/*!	Keeps the output in memory, in vectors growing with the simulation.	*/
+class MemorySink : public OutputSink
+{
+	public:
+	//! Spike kept in memory
+	struct Spike
+	{	unsigned int step;		/**<	Time step of the spike.							*/
+		unsigned int neuron;	/**<	Index of the neuron which spiked.				*/
+		double potential;		/**<	Membrane potential of the neuron when it spiked.	*/
+	};
+
+	private:
+	vector<Spike> spikes_;			/**<	Spikes, in the order of the simulation.			*/
+	vector<unsigned int> steps_;	/**<	Time steps written.								*/
+	vector<unsigned int> counts_;	/**<	Number of spikes of each time step written.		*/
+
+	public:
+	//! Constructor
+	/*!	@param capacity: Number of spikes for which memory is reserved, for instance MeanField::getExpectedSpikes.	*/
+	explicit MemorySink(size_t capacity=0);
+
+/***************************************************/
+	/*	Getters	*/
+	//! Gets the spikes
+	vector<Spike> const& getSpikes() const;
+	//! Gets the time steps written
+	vector<unsigned int> const& getSteps() const;
+	//! Gets the number of spikes of each time step written
+	vector<unsigned int> const& getCounts() const;
+
+/***************************************************/
+	void writeSpike(unsigned int const& step, unsigned int const& neuron, double const& potential) override;
+	void writeStep(unsigned int const& step, unsigned int const& spikes) override;
+};
+
+//! NullSink class
+/*!	Discards the output.	*/
+class NullSink : public OutputSink
+{
+	public:
+	void writeSpike(unsigned int const&, unsigned int const&, double const&) override {}
+	void writeStep(unsigned int const&, unsigned int const&) override {}
+};
+
+#endif
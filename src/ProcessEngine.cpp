@@ -0,0 +1,492 @@
+#include "ProcessEngine.hpp"
+#include <cassert>
+#include <cerrno>
+#include <ctime>
+#include <csignal>
+#include <algorithm>
+#include <stdexcept>
+#include <system_error>
+#include <sys/mman.h>
+#include <sys/prctl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <sched.h>
+
+/*	A process killed while holding the mutex of the barrier leaves it to the next process locking it, which
+ * 	makes it usable again.	*/
+static int recover(pthread_mutex_t* mutex, int const& result)
+{	if(result==EOWNERDEAD)
+	{	pthread_mutex_consistent(mutex);
+	}
+	return result;
+}
+
+ProcessEngine::ProcessEngine(Network& network, unsigned int workers, Topology const& topology)
+	:	network_(network), workers_(workers), topology_(topology), pinning_(true), capacity_(0), depth_(0), shared_(nullptr), shared_size_(0), control_(nullptr),
+		counts_(nullptr), spikes_(nullptr), potentials_(nullptr), refractory_(nullptr), present_(nullptr), buffers_(nullptr),
+		noise_(nullptr), noise_time_(nullptr)
+{	assert(workers_>0);
+	
+	/*	The CPUs of the machine are taken node after node, and the workers are spread evenly over them:
+	 * 	consecutive workers, which own consecutive neurons, share the same node.	*/
+	vector<unsigned int> nodes, cpus;
+	for(unsigned int n(0);n<topology_.getNodes();++n)
+	{	for(size_t c(0);c<topology_.getCpus(n).size();++c)
+		{	nodes.push_back(n);
+			cpus.push_back(topology_.getCpus(n)[c]);
+		}
+	}
+	for(unsigned int w(0);w<workers_;++w)
+	{	size_t index(size_t(w)*cpus.size()/workers_);
+		nodes_.push_back(nodes[index]);
+		cpus_.push_back(cpus[index]);
+	}
+}
+
+ProcessEngine::~ProcessEngine()
+{	unmap();
+}
+
+/***************************************************/
+
+unsigned int ProcessEngine::getWorkers() const
+{	return workers_;
+}
+
+size_t ProcessEngine::getPartition(unsigned int const& worker) const
+{	assert(worker<=workers_);
+	/*	The neurons are shared as evenly as possible between the workers.	*/
+	return network_.neurons_.size()*worker/workers_;
+}
+
+unsigned int ProcessEngine::getNode(unsigned int const& worker) const
+{	assert(worker<workers_);
+	return nodes_[worker];
+}
+
+unsigned int ProcessEngine::getCpu(unsigned int const& worker) const
+{	assert(worker<workers_);
+	return cpus_[worker];
+}
+
+Topology const& ProcessEngine::getTopology() const
+{	return topology_;
+}
+
+bool ProcessEngine::getPinning() const
+{	return pinning_;
+}
+
+ProcessEngine::Spike* ProcessEngine::getSpikes(unsigned int const& worker) const
+{	return spikes_+worker*capacity_;
+}
+
+/***************************************************/
+
+void ProcessEngine::setPinning(bool const& pinning)
+{	pinning_=pinning;
+}
+
+/***************************************************/
+
+void ProcessEngine::update(double const& endtime)
+{
+	/*	Conversion of the time given in time steps.	*/
+	unsigned int end(endtime/dt);
+
+	bool finished(network_.classifier_!=nullptr && network_.classifier_->isFinished());
+	if(network_.clock_time_>=end || finished)
+	{	return;
+	}
+
+	/*	Verifies if there are enough neurons in the network for all workers.	*/
+	assert(network_.neurons_.size()>=workers_);
+	
+	/*	The inputs may have been set since the last simulation.	*/
+	if(network_.stimuli_!=nullptr)
+	{	network_.readInputs();
+	}
+
+	map();
+
+	/*	All neurons start in the active set, in the workers which inherit the state of the network.	*/
+	network_.activate(0, network_.neurons_.size());
+
+	pids_.assign(workers_, 0);
+	for(unsigned int w(0);w<workers_;++w)
+	{	pid_t pid(fork());
+		if(pid<0)
+		{	int error(errno);
+			fail();
+			throw system_error(error, generic_category(), "ProcessEngine: cannot create worker "+to_string(w));
+		}
+		if(pid==0)
+		{	/*	The worker dies with the network, and leaves without destroying the objects of the network,
+			 * 	which belong to the parent. An exception must not reach the code of the parent either.	*/
+			prctl(PR_SET_PDEATHSIG, SIGKILL);
+			int status(0);
+			try
+			{	work(w, end);
+			} catch(...)
+			{	status=1;
+			}
+			_exit(status);
+		}
+		pids_[w]=pid;
+	}
+
+	bool stop(false);
+	while(!stop)
+	{
+		unsigned int begin(network_.clock_time_);
+		unsigned int interval(min<unsigned int>(network_.getMinDelay(), end-begin));
+
+		/*	Waits for the workers to write the spikes of the interval.	*/
+		if(!wait(true))
+		{	break;
+		}
+
+		finished=record(begin, interval);
+		stop=(finished || network_.clock_time_>=end);
+		control_->stop=stop;
+
+		/*	Waits for the workers to deliver the spikes and for the decision of the network.	*/
+		if(!wait(true))
+		{	break;
+		}
+	}
+
+	if(!stop || !collect(true))
+	{	fail();
+		throw runtime_error("ProcessEngine: a worker has died during the simulation");
+	}
+
+	/*	The state written by the workers is copied back in the neurons of the network.	*/
+	for(size_t i(0);i<network_.neurons_.size();++i)
+	{	Neuron* neuron(network_.neurons_[i]);
+		neuron->setMembranePotential(potentials_[i]);
+		neuron->setRefractoryTime(refractory_[i]);
+		neuron->setPresentTime(present_[i]);
+		if(network_.stimuli_!=nullptr)
+		{	neuron->setInput(network_.base_inputs_[i]+network_.stimuli_->getCurrent(i));
+		}
+		for(unsigned int k(0);k<depth_;++k)
+		{	neuron->setBuffer(k, buffers_[i*depth_+k]);
+		}
+		if(network_.input_==OrnsteinUhlenbeckInput)
+		{	network_.noise_[i]=noise_[i];
+			network_.noise_time_[i]=noise_time_[i];
+		}
+	}
+
+	unmap();
+}
+
+void ProcessEngine::report(ostream& out) const
+{	topology_.print(out);
+	for(unsigned int w(0);w<workers_;++w)
+	{	out<<"worker "<<w<<": node "<<topology_.getId(nodes_[w])<<", cpu "<<cpus_[w]
+			<<(pinning_ ? "" : " (not pinned)")<<", neurons "<<getPartition(w)<<" to "<<getPartition(w+1)<<endl;
+	}
+}
+
+void ProcessEngine::map()
+{
+	size_t neurons(network_.neurons_.size());
+	partition_.clear();
+	for(unsigned int w(0);w<=workers_;++w)
+	{	partition_.push_back(getPartition(w));
+	}
+
+	/*	A neuron spikes at most once per time step.	*/
+	capacity_=0;
+	for(unsigned int w(0);w<workers_;++w)
+	{	capacity_=max(capacity_, (partition_[w+1]-partition_[w])*network_.getMinDelay());
+	}
+
+	/*	The ring buffers of all neurons are copied with the depth of the deepest one.	*/
+	depth_=0;
+	for(size_t i(0);i<neurons;++i)
+	{	depth_=max(depth_, network_.neurons_[i]->getBufferDepth());
+	}
+
+	/*	Layout of the region: control, spike counts, spikes, then the state of the neurons. Each part is
+	 * 	aligned for the types which follow. Only the control is touched here: the spikes of a worker are
+	 * 	written first by the worker, so that their pages are placed on its node.	*/
+	size_t control(0);
+	size_t counts(control+(sizeof(Control)+sizeof(double)-1)/sizeof(double)*sizeof(double));
+	size_t spikes(counts+(workers_*sizeof(unsigned int)+sizeof(double)-1)/sizeof(double)*sizeof(double));
+	size_t potentials(spikes+workers_*capacity_*sizeof(Spike));
+	size_t buffers(potentials+neurons*sizeof(double));
+	size_t noise(buffers+neurons*depth_*sizeof(double));
+	size_t refractory(noise+neurons*sizeof(double));
+	size_t present(refractory+neurons*sizeof(unsigned int));
+	size_t noise_time(present+neurons*sizeof(unsigned int));
+	shared_size_=noise_time+neurons*sizeof(unsigned int);
+
+	void* region(mmap(nullptr, shared_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0));
+	if(region==MAP_FAILED)
+	{	shared_size_=0;
+		throw system_error(errno, generic_category(), "ProcessEngine: cannot map the shared memory region");
+	}
+	shared_=static_cast<char*>(region);
+
+	control_=reinterpret_cast<Control*>(shared_+control);
+	counts_=reinterpret_cast<unsigned int*>(shared_+counts);
+	spikes_=reinterpret_cast<Spike*>(shared_+spikes);
+	potentials_=reinterpret_cast<double*>(shared_+potentials);
+	buffers_=reinterpret_cast<double*>(shared_+buffers);
+	noise_=reinterpret_cast<double*>(shared_+noise);
+	noise_time_=reinterpret_cast<unsigned int*>(shared_+noise_time);
+	refractory_=reinterpret_cast<unsigned int*>(shared_+refractory);
+	present_=reinterpret_cast<unsigned int*>(shared_+present);
+
+	/*	The barrier is shared by the workers and the network. Unlike a pthread barrier, it lets the network
+	 * 	stop waiting when a worker dies.	*/
+	pthread_mutexattr_t mutex;
+	pthread_mutexattr_init(&mutex);
+	pthread_mutexattr_setpshared(&mutex, PTHREAD_PROCESS_SHARED);
+	pthread_mutexattr_setrobust(&mutex, PTHREAD_MUTEX_ROBUST);
+	pthread_mutex_init(&control_->mutex, &mutex);
+	pthread_mutexattr_destroy(&mutex);
+	pthread_condattr_t condition;
+	pthread_condattr_init(&condition);
+	pthread_condattr_setpshared(&condition, PTHREAD_PROCESS_SHARED);
+	pthread_condattr_setclock(&condition, CLOCK_MONOTONIC);
+	pthread_cond_init(&control_->condition, &condition);
+	pthread_condattr_destroy(&condition);
+	control_->arrived=0;
+	control_->generation=0;
+	control_->stop=0;
+	control_->failed=0;
+}
+
+void ProcessEngine::unmap()
+{	if(shared_!=nullptr)
+	{	pthread_cond_destroy(&control_->condition);
+		pthread_mutex_destroy(&control_->mutex);
+		munmap(shared_, shared_size_);
+		shared_=nullptr;
+		shared_size_=0;
+	}
+}
+
+bool ProcessEngine::wait(bool const& network)
+{	recover(&control_->mutex, pthread_mutex_lock(&control_->mutex));
+	unsigned int generation(control_->generation);
+	if(++control_->arrived==workers_+1)
+	{	control_->arrived=0;
+		++control_->generation;
+		pthread_cond_broadcast(&control_->condition);
+	}
+	while(control_->generation==generation && !control_->failed)
+	{	if(!network)
+		{	recover(&control_->mutex, pthread_cond_wait(&control_->condition, &control_->mutex));
+			continue;
+		}
+		
+		/*	The workers only exit once the last barrier has been reached, so a worker which has exited while
+		 * 	the barrier is not complete has died. The other workers are woken up to stop.	*/
+		timespec deadline;
+		clock_gettime(CLOCK_MONOTONIC, &deadline);
+		deadline.tv_nsec+=10000000;
+		if(deadline.tv_nsec>=1000000000)
+		{	deadline.tv_nsec-=1000000000;
+			++deadline.tv_sec;
+		}
+		if(recover(&control_->mutex, pthread_cond_timedwait(&control_->condition, &control_->mutex, &deadline))!=0
+			&& control_->generation==generation && !collect(false))
+		{	control_->failed=1;
+			pthread_cond_broadcast(&control_->condition);
+		}
+	}
+	bool reached(control_->generation!=generation);
+	pthread_mutex_unlock(&control_->mutex);
+	return reached;
+}
+
+bool ProcessEngine::collect(bool const& block)
+{	bool exited(true);
+	for(size_t w(0);w<pids_.size();++w)
+	{	int status(0);
+		if(pids_[w]!=0 && waitpid(pids_[w], &status, block ? 0 : WNOHANG)==pids_[w])
+		{	pids_[w]=0;
+			exited=exited && WIFEXITED(status) && WEXITSTATUS(status)==0;
+		}
+	}
+	return exited;
+}
+
+void ProcessEngine::fail()
+{	if(control_!=nullptr && shared_!=nullptr)
+	{	recover(&control_->mutex, pthread_mutex_lock(&control_->mutex));
+		control_->failed=1;
+		pthread_cond_broadcast(&control_->condition);
+		pthread_mutex_unlock(&control_->mutex);
+	}
+	for(size_t w(0);w<pids_.size();++w)
+	{	if(pids_[w]!=0)
+		{	kill(pids_[w], SIGKILL);
+		}
+	}
+	collect(true);
+	unmap();
+}
+
+void ProcessEngine::pin(unsigned int const& worker) const
+{	if(!pinning_)
+	{	return;
+	}
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	CPU_SET(cpus_[worker], &set);
+	if(sched_setaffinity(0, sizeof(set), &set)!=0)
+	{	/*	The CPU may be out of the ones allowed for the process: the worker stays on its node.	*/
+		CPU_ZERO(&set);
+		vector<unsigned int> const& cpus(topology_.getCpus(nodes_[worker]));
+		for(size_t c(0);c<cpus.size();++c)
+		{	CPU_SET(cpus[c], &set);
+		}
+		
+		/*	If the node is not available either, the worker runs where the system places it.	*/
+		sched_setaffinity(0, sizeof(set), &set);
+	}
+}
+
+void ProcessEngine::connect(unsigned int const& worker)
+{
+	/*	Only the connections towards the neurons of the worker are kept, in the order of the network.	*/
+	size_t first(partition_[worker]), last(partition_[worker+1]);
+	offsets_.assign(1, 0);
+	targets_.clear();
+	delays_.clear();
+	for(size_t i(0);i<network_.neurons_.size();++i)
+	{	for(unsigned int delay(network_.getMinDelay());delay<=network_.getMaxDelay();++delay)
+		{	View<unsigned int const> targets(network_.getTargets(i, delay));
+			for(size_t j(0);j<targets.size();++j)
+			{	if(targets[j]>=first && targets[j]<last)
+				{	targets_.push_back(targets[j]);
+					delays_.push_back(delay);
+				}
+			}
+		}
+		offsets_.push_back(targets_.size());
+	}
+}
+
+void ProcessEngine::work(unsigned int const& worker, unsigned int const& end)
+{
+	/*	The worker is pinned before touching any memory, so that the connections it builds and the
+	 * 	state of its neurons, copied when first written, are allocated on its node.	*/
+	pin(worker);
+	connect(worker);
+
+	size_t first(partition_[worker]), last(partition_[worker+1]);
+	Spike* written(getSpikes(worker));
+	bool stop(false);
+
+	while(!stop)
+	{
+		unsigned int begin(network_.clock_time_);
+		unsigned int interval(min<unsigned int>(network_.getMinDelay(), end-begin));
+
+		/*	The spikes of the interval are only read after the shortest delay, so the neurons of the worker
+		 * 	can be simulated without the spikes of the other workers.	*/
+		counts_[worker]=0;
+		for(unsigned int step(0);step<interval;++step)
+		{	if(network_.stimuli_!=nullptr)
+			{	network_.applyStimuli(first, last);
+			}
+			if(network_.source_!=nullptr)
+			{	network_.fireExternal(first, last);
+			}
+			network_.spikes_.clear();
+			network_.integrate(first, last, network_.spikes_);
+			for(size_t k(0);k<network_.spikes_.size();++k)
+			{	unsigned int neuron(network_.spikes_[k]);
+				Spike spike = {network_.clock_time_, neuron, network_.neurons_[neuron]->getMembranePotential()};
+				written[counts_[worker]++]=spike;
+			}
+			++network_.clock_time_;
+		}
+
+		/*	Waits for all the spikes of the interval. If a worker has died, the network kills the others.	*/
+		if(!wait(false))
+		{	_exit(1);
+		}
+
+		exchange(begin);
+
+		/*	Waits for the decision of the network.	*/
+		if(!wait(false))
+		{	_exit(1);
+		}
+		stop=control_->stop;
+	}
+
+	/*	The state of the neurons of the worker is written for the network.	*/
+	network_.synchronize(first, last);
+	for(size_t i(first);i<last;++i)
+	{	Neuron* neuron(network_.neurons_[i]);
+		potentials_[i]=neuron->getMembranePotential();
+		refractory_[i]=neuron->getRefractoryTime();
+		present_[i]=neuron->getPresentTime();
+		for(unsigned int k(0);k<depth_;++k)
+		{	buffers_[i*depth_+k]=neuron->getBuffer(k);
+		}
+		if(network_.input_==OrnsteinUhlenbeckInput)
+		{	noise_[i]=network_.noise_[i];
+			noise_time_[i]=network_.noise_time_[i];
+		}
+	}
+}
+
+void ProcessEngine::exchange(unsigned int const& begin)
+{
+	/*	The spikes of each worker are ordered by time step, then by neuron, and the workers own
+	 * 	increasing ranges of neurons.	*/
+	vector<unsigned int> read(workers_, 0);
+	for(unsigned int step(begin);step<network_.clock_time_;++step)
+	{	for(unsigned int w(0);w<workers_;++w)
+		{	Spike* spikes(getSpikes(w));
+			for(;read[w]<counts_[w] && spikes[read[w]].step==step;++read[w])
+			{	unsigned int neuron(spikes[read[w]].neuron);
+				double amplitude(network_.getAmplitude(neuron));
+				for(size_t j(offsets_[neuron]);j<offsets_[neuron+1];++j)
+				{	network_.deliver(targets_[j], amplitude, step+delays_[j]);
+				}
+			}
+		}
+	}
+}
+
+bool ProcessEngine::record(unsigned int const& begin, unsigned int const& interval)
+{
+	bool finished(false);
+	vector<unsigned int> read(workers_, 0);
+	for(unsigned int step(begin);step<begin+interval;++step)
+	{	network_.clock_time_=step;
+		unsigned int number_spikes(0);
+		
+		/*	The stimuli and the spike source of the network follow the ones of the workers, which apply them
+		 * 	in their copies. Since the neurons of the network are overwritten at the end, only the timeline
+		 * 	of the stimuli advances.	*/
+		if(network_.stimuli_!=nullptr)
+		{	network_.stimuli_->apply(step, [](unsigned int, double){});
+		}
+		if(network_.source_!=nullptr)
+		{	network_.source_->fire(step);
+		}
+		for(unsigned int w(0);w<workers_;++w)
+		{	Spike* spikes(getSpikes(w));
+			for(;read[w]<counts_[w] && spikes[read[w]].step==step;++read[w])
+			{	network_.neurons_[spikes[read[w]].neuron]->addTimeValue(step);
+				network_.recordSpike(spikes[read[w]].neuron, spikes[read[w]].potential);
+				++number_spikes;
+			}
+		}
+		finished=network_.recordStep(number_spikes) || finished;
+	}
+	network_.clock_time_=begin+interval;
+	return finished;
+}
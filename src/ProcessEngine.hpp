@@ -0,0 +1,214 @@
+#ifndef PROCESSENGINE_H
+#define PROCESSENGINE_H
+
+#include "Network.hpp"
+#include "Topology.hpp"
+#include <vector>
+#include <pthread.h>
+
+using namespace std;
+
+//! ProcessEngine class
+/*!	Simulates a network with several local worker processes. The neurons are partitioned in contiguous
+ * 	ranges, each worker owning the state of its range and the connections towards it.
+ *
+ * 	Since a spike is only read the shortest delay of the synapses after it occurred, the workers simulate
+ * 	intervals of this delay independently. At the end of each interval, they write the spikes of their
+ * 	neurons in a shared memory region, wait for each other, and deliver all the spikes to their own
+ * 	neurons in the order of the single process simulation. Meanwhile, the network records the spikes
+ * 	in its files and statistics, and decides whether the simulation has to stop.
+ *
+ * 	The workers are spread over the NUMA nodes of the machine, consecutive workers sharing a node, and
+ * 	each one is pinned to a CPU of its node. The state of the neurons of a worker, their buffers and the
+ * 	connections towards them are written for the first time by the pinned worker, so that the kernel
+ * 	places them in the memory of its node, the state being copied on write from the network.
+ *
+ * 	The spike trains are the same as the ones of Network::update, the random spikes of a neuron at a time
+ * 	step being drawn by a counter-based generator from the seed of the network. Each worker applies its copies
+ * 	of the stimuli and of the spike source of the network, if any, to its own neurons. A simulation stopped
+ * 	by the classifier stops at the end of the interval in which the regime has been decided.
+ *
+ * 	While it waits for the workers, the network checks that none of them has died. A worker which crashes,
+ * 	is killed or throws stops the simulation: the other workers are killed, and update throws instead of
+ * 	waiting for them forever.	*/
+class ProcessEngine
+{
+	private:
+
+	/*!	Spike written by a worker in the shared memory region.	*/
+	struct Spike
+	{	unsigned int step;		/**<	Time step of the spike.										*/
+		unsigned int neuron;	/**<	Index of the neuron which spiked.							*/
+		double potential;		/**<	Membrane potential of the neuron when it spiked.			*/
+	};
+
+	/*!	Synchronization of the processes, at the beginning of the shared memory region.	*/
+	struct Control
+	{	pthread_mutex_t mutex;			/**<	Mutex of the barrier shared by the workers and the network.		*/
+		pthread_cond_t condition;		/**<	Signaled when all processes have reached the barrier.			*/
+		unsigned int arrived;			/**<	Number of processes waiting at the barrier.						*/
+		unsigned int generation;		/**<	Number of times all processes have reached the barrier.			*/
+		int stop;						/**<	Set by the network when the simulation has to stop.				*/
+		int failed;						/**<	Set by the network when a worker has died.						*/
+	};
+
+	Network& network_;					/**<	Network simulated.														*/
+	unsigned int workers_;				/**<	Number of worker processes.												*/
+	Topology topology_;					/**<	NUMA nodes of the machine.												*/
+	vector<unsigned int> nodes_;		/**<	Node of each worker.													*/
+	vector<unsigned int> cpus_;			/**<	CPU of each worker.														*/
+	vector<pid_t> pids_;				/**<	Process of each worker during a simulation, 0 once it has been waited for.	*/
+	bool pinning_;						/**<	Whether the workers are pinned to their CPU.							*/
+	vector<size_t> partition_;			/**<	First neuron of each worker, followed by the number of neurons.			*/
+	size_t capacity_;					/**<	Maximum number of spikes of a worker during an interval.				*/
+	unsigned int depth_;				/**<	Depth of the ring buffers of the neurons.								*/
+
+	char* shared_;						/**<	Shared memory region, mapped during a simulation.						*/
+	size_t shared_size_;				/**<	Size of the shared memory region in bytes.								*/
+	Control* control_;					/**<	Synchronization of the processes.										*/
+	unsigned int* counts_;				/**<	Number of spikes written by each worker during the present interval.	*/
+	Spike* spikes_;						/**<	Spikes written by each worker, capacity_ per worker.					*/
+	double* potentials_;				/**<	Membrane potentials of the neurons at the end of the simulation.		*/
+	unsigned int* refractory_;			/**<	Refractory times of the neurons at the end of the simulation.			*/
+	unsigned int* present_;				/**<	Present times of the neurons at the end of the simulation.				*/
+	double* buffers_;					/**<	Buffers of the neurons at the end of the simulation.					*/
+	double* noise_;						/**<	Ornstein-Uhlenbeck noise of the neurons at the end of the simulation.	*/
+	unsigned int* noise_time_;			/**<	Time steps of the last draws of their noise.							*/
+
+	vector<size_t> offsets_;			/**<	In a worker, first connection of each neuron of the network.			*/
+	vector<unsigned int> targets_;		/**<	In a worker, targets of the connections, all owned by the worker.		*/
+	vector<unsigned int> delays_;		/**<	In a worker, delays of the connections in time steps.					*/
+
+	public:
+	//! Constructor
+	/*!	@param network: Network simulated.
+	 * 	@param workers: Number of worker processes.
+	 * 	@param topology: NUMA nodes on which the workers are placed, the ones of the machine by default.	*/
+	ProcessEngine(Network& network, unsigned int workers, Topology const& topology=Topology());
+
+	//! Destructor
+	/*!	Unmaps the shared memory region if a simulation has been interrupted.	*/
+	~ProcessEngine();
+
+	/*!	The engine cannot be copied, since it refers to the network and owns the shared memory region.	*/
+	ProcessEngine(ProcessEngine const&) = delete;
+	ProcessEngine& operator=(ProcessEngine const&) = delete;
+
+	/*********************************************************************************************************************
+	 * 											GETTERS																	 *
+	 * *******************************************************************************************************************/
+
+	//!A public getter
+	/*!	@return unsigned int: Number of worker processes.	*/
+	unsigned int getWorkers() const;
+
+	//!A public getter taking an unsigned int as parameter
+	/*!	@param worker: Index of a worker.
+	 * 	@return size_t: First neuron owned by the worker, or the number of neurons for the index workers_.	*/
+	size_t getPartition(unsigned int const& worker) const;
+
+	//!A public getter taking an unsigned int as parameter
+	/*!	@param worker: Index of a worker.
+	 * 	@return unsigned int: Index of the node of the worker in the topology.	*/
+	unsigned int getNode(unsigned int const& worker) const;
+
+	//!A public getter taking an unsigned int as parameter
+	/*!	@param worker: Index of a worker.
+	 * 	@return unsigned int: CPU of the worker.	*/
+	unsigned int getCpu(unsigned int const& worker) const;
+
+	//!A public getter
+	/*!	@return Topology const&: NUMA nodes on which the workers are placed.	*/
+	Topology const& getTopology() const;
+
+	//!A public getter
+	/*!	@return bool: Whether the workers are pinned to their CPU.	*/
+	bool getPinning() const;
+
+	/*********************************************************************************************************************
+	 * 											SETTERS																	 *
+	 * *******************************************************************************************************************/
+
+	//!A public setter taking a bool as parameter
+	/*!	@param pinning: Whether the workers are pinned to their CPU.	*/
+	void setPinning(bool const& pinning);
+
+	/*********************************************************************************************************************
+	 * 											METHODS																	 *
+	 * *******************************************************************************************************************/
+
+	//!A public function taking a double as parameter
+	/*!	Simulates the network with the worker processes, like Network::update. Throws a system_error if the
+	 * 	shared memory region or a worker cannot be created, and a runtime_error if a worker dies. The network
+	 * 	then keeps the spikes recorded before the failure, but not the state reached by its neurons.
+	 * 	@param endtime: Time at which the simulation will end.	*/
+	void update(double const& endtime);
+
+	//!A public function taking an ostream as parameter
+	/*!	Writes the placement of the workers: node, CPU and range of neurons of each one.
+	 * 	@param out: Stream written.	*/
+	void report(ostream& out) const;
+
+	private:
+	//!A private function
+	/*!	Partitions the neurons of the network and maps the shared memory region.	*/
+	void map();
+
+	//!A private function
+	/*!	Unmaps the shared memory region.	*/
+	void unmap();
+
+	//!A private function taking a bool as parameter
+	/*!	Waits until the network and all workers have reached the barrier of the shared memory region.
+	 * 	Meanwhile, the network checks every few milliseconds that no worker has died.
+	 * 	@param network: Whether the calling process is the network.
+	 * 	@return bool: Whether all processes have reached the barrier, false if a worker has died.	*/
+	bool wait(bool const& network);
+
+	//!A private function taking a bool as parameter
+	/*!	Waits for the worker processes which have not been waited for yet.
+	 * 	@param block: Whether to wait until they exit, or only to collect the ones which have exited.
+	 * 	@return bool: Whether the workers collected have exited normally.	*/
+	bool collect(bool const& block);
+
+	//!A private function
+	/*!	Stops a simulation which has failed: the workers left are killed and waited for, and the shared
+	 * 	memory region is unmapped.	*/
+	void fail();
+
+	//!A private function taking an unsigned int as parameter
+	/*!	Pins the calling worker process to its CPU, or to the CPUs of its node if the CPU is not available.
+	 * 	@param worker: Index of the worker.	*/
+	void pin(unsigned int const& worker) const;
+
+	//!A private function taking an unsigned int as parameter
+	/*!	Builds the connections of the network towards the neurons owned by a worker.
+	 * 	@param worker: Index of the worker.	*/
+	void connect(unsigned int const& worker);
+
+	//!A private function taking two unsigned int as parameters
+	/*!	Simulation in a worker process.
+	 * 	@param worker: Index of the worker.
+	 * 	@param end: Time step at which the simulation will end.	*/
+	void work(unsigned int const& worker, unsigned int const& end);
+
+	//!A private function taking an unsigned int as parameter
+	/*!	Delivers the spikes of the last interval to the neurons owned by the worker, in the order of the
+	 * 	single process simulation: by time step, then by neuron.
+	 * 	@param begin: First time step of the interval.	*/
+	void exchange(unsigned int const& begin);
+
+	//!A private function taking two unsigned int as parameters
+	/*!	Records the spikes of the last interval in the network.
+	 * 	@param begin: First time step of the interval.
+	 * 	@param interval: Number of time steps of the interval.
+	 * 	@return bool: Whether the classifier has decided to stop the simulation.	*/
+	bool record(unsigned int const& begin, unsigned int const& interval);
+
+	//!A private function taking an unsigned int as parameter
+	/*!	@param worker: Index of a worker.
+	 * 	@return Spike*: Spikes written by the worker.	*/
+	Spike* getSpikes(unsigned int const& worker) const;
+};
+
+#endif
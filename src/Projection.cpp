@@ -0,0 +1,51 @@
+#include "Projection.hpp"
+#include <cassert>
+
+Projection::Projection(unsigned int sources)
+	:	offsets_(sources+1), targets_(sources)
+{	for(unsigned int k(0);k<=sources;++k)
+	{	offsets_[k]=k;
+	}
+	for(unsigned int k(0);k<sources;++k)
+	{	targets_[k]=k;
+	}
+}
+
+Projection::Projection(unsigned int neurons, unsigned int sources, unsigned int connections, CounterRandom const& random)
+	:	offsets_(sources+1, 0), targets_(static_cast<size_t>(neurons)*connections)
+{	assert(sources>0);
+
+	/*	The source of each link is drawn twice: once to count the targets of the sources, once to place
+	 * 	them, so that the projection is built without storing the links neuron by neuron. The neurons are
+	 * 	placed in increasing order.	*/
+	for(unsigned int i(0);i<neurons;++i)
+	{	for(unsigned int j(0);j<connections;++j)
+		{	++offsets_[random.uniform(ExternalLinkStream, i, j, 0, sources)+1];
+		}
+	}
+	for(unsigned int k(0);k<sources;++k)
+	{	offsets_[k+1]+=offsets_[k];
+	}
+	vector<size_t> next(offsets_.begin(), offsets_.end()-1);
+	for(unsigned int i(0);i<neurons;++i)
+	{	for(unsigned int j(0);j<connections;++j)
+		{	targets_[next[random.uniform(ExternalLinkStream, i, j, 0, sources)]++]=i;
+		}
+	}
+}
+
+/***************************************************/
+/*	Getters	*/
+
+unsigned int Projection::getSources() const
+{	return offsets_.size()-1;
+}
+
+size_t Projection::getLinks() const
+{	return targets_.size();
+}
+
+View<unsigned int const> Projection::getTargets(unsigned int const& source) const
+{	assert(source<getSources());
+	return View<unsigned int const>(targets_.data()+offsets_[source], offsets_[source+1]-offsets_[source]);
+}
@@ -0,0 +1,44 @@
+#ifndef PROJECTION_H
+#define PROJECTION_H
+
+#include <vector>
+#include "CounterRandom.hpp"
+#include "Utility/View.hpp"
+
+using namespace std;
+
+//! Projection class
+/*!	Links from sources outside a network, such as external generators or recorded neurons, to the neurons
+ * 	of the network. The links are stored source by source, each source's targets sorted, so that a spike
+ * 	of a source is delivered to all its targets at once.	*/
+class Projection
+{
+	private:
+	vector<size_t> offsets_;		/**<	First target of each source in targets_, followed by the number of links.	*/
+	vector<unsigned int> targets_;	/**<	Neurons receiving the spikes of each source, source after source.		*/
+
+	public:
+	//! Constructor
+	/*!	Links each source to the neuron of the same index.
+	 * 	@param sources: Number of sources, and of neurons driven.	*/
+	explicit Projection(unsigned int sources);
+
+	//! Constructor
+	/*!	Links each neuron to sources drawn at random, with repetitions.
+	 * 	@param neurons: Number of neurons driven.
+	 * 	@param sources: Number of sources.
+	 * 	@param connections: Number of sources linked to each neuron.
+	 * 	@param random: Generator of the links, drawn from ExternalLinkStream.	*/
+	Projection(unsigned int neurons, unsigned int sources, unsigned int connections, CounterRandom const& random);
+
+/***************************************************/
+	/*	Getters	*/
+	//! Gets the number of sources
+	unsigned int getSources() const;
+	//! Gets the number of links
+	size_t getLinks() const;
+	//! Gets the neurons receiving the spikes of a source, in increasing order
+	View<unsigned int const> getTargets(unsigned int const& source) const;
+};
+
+#endif
@@ -0,0 +1,113 @@
+#include "RegimeClassifier.hpp"
+#include <cmath>
+
+constexpr double RegimeClassifier::SynchronyThreshold;
+constexpr double RegimeClassifier::RegularityThreshold;
+constexpr double RegimeClassifier::FastOscillation;
+constexpr double RegimeClassifier::FastRate;
+constexpr double RegimeClassifier::SaturationFraction;
+
+RegimeClassifier::RegimeClassifier(unsigned int window_bins, double tolerance, unsigned int stable_windows)
+	:	window_bins_(window_bins), tolerance_(tolerance), stable_windows_(stable_windows), regime_(Undetermined),
+		finished_(false), windows_(0), stable_(0), rate_(0.0), last_bins_(0), last_steps_(0), last_spikes_(0.0)
+{}
+
+/***************************************************/
+/*	Getters	*/
+
+Regime RegimeClassifier::getRegime() const
+{	return regime_;
+}
+
+bool RegimeClassifier::isFinished() const
+{	return finished_;
+}
+
+double RegimeClassifier::getRate() const
+{	return rate_;
+}
+
+string RegimeClassifier::getName(Regime const& regime)
+{	switch(regime)
+	{	case Quiescent:					return "quiescent";
+		case Saturated:					return "saturated";
+		case SynchronousRegular:		return "SR";
+		case SynchronousIrregularFast:	return "SI fast";
+		case SynchronousIrregularSlow:	return "SI slow";
+		case AsynchronousIrregular:		return "AI";
+		default:						return "undetermined";
+	}
+}
+
+/***************************************************/
+
+bool RegimeClassifier::update(SpikeStatistics& statistics, double const& peak_frequency)
+{	
+	/*	Nothing to do before a window has been completed.	*/
+	if(finished_ || statistics.getBins()<last_bins_+window_bins_)
+	{	return finished_;
+	}
+	++windows_;
+	last_bins_=statistics.getBins();
+	
+	/*	Mean rate during the window, from the spikes per neuron recorded since the last evaluation.	*/
+	double spikes(statistics.getMeanRate()*statistics.getSteps()*dt/1000.0);
+	unsigned int steps(statistics.getSteps()-last_steps_);
+	double rate((spikes-last_spikes_)*1000.0/(steps*dt));
+	last_spikes_=spikes;
+	last_steps_=statistics.getSteps();
+	
+	/*	The first window contains the initial transient, which must not weigh in the regime: the statistics
+	 * 	start again from the second window.	*/
+	if(windows_==1)
+	{	rate_=rate;
+		statistics.reset();
+		last_bins_=0;
+		last_steps_=0;
+		last_spikes_=0.0;
+		return false;
+	}
+	
+	/*	A window is stable if its rate is close to the one of the previous window, or if the network
+	 * 	is still dead.	*/
+	bool stable(rate==rate_ || fabs(rate-rate_)<=tolerance_*rate_);
+	rate_=rate;
+	stable_= stable ? stable_+1 : 0;
+	
+	if(stable_>=stable_windows_)
+	{	regime_=classify(statistics, peak_frequency);
+		
+		/*	The death or saturation of the network is decided on the last window only.	*/
+		if(rate_==0.0)
+		{	regime_=Quiescent;
+		} else if(rate_>=SaturationFraction*1000.0/(RefractoryPeriod*dt))
+		{	regime_=Saturated;
+		}
+		finished_=true;
+	}
+	return finished_;
+}
+
+Regime RegimeClassifier::classify(SpikeStatistics const& statistics, double const& peak_frequency)
+{	
+	double rate(statistics.getMeanRate());
+	if(rate==0.0)
+	{	return Quiescent;
+	}
+	if(rate>=SaturationFraction*1000.0/(RefractoryPeriod*dt))
+	{	return Saturated;
+	}
+	if(statistics.getSynchrony()<SynchronyThreshold)
+	{	return AsynchronousIrregular;
+	}
+	if(statistics.getMeanCV()<RegularityThreshold)
+	{	return SynchronousRegular;
+	}
+	
+	/*	Synchronous irregular activity: the speed of the oscillation is given by the dominant frequency, 
+	 * 	or, if it is unknown, guessed from the mean rate which is much lower in the slow regime.	*/
+	if(peak_frequency>0.0)
+	{	return peak_frequency>=FastOscillation ? SynchronousIrregularFast : SynchronousIrregularSlow;
+	}
+	return rate>=FastRate ? SynchronousIrregularFast : SynchronousIrregularSlow;
+}
@@ -0,0 +1,101 @@
+#ifndef REGIMECLASSIFIER_H
+#define REGIMECLASSIFIER_H
+
+#include <string>
+#include "SpikeStatistics.hpp"
+
+using namespace std;
+
+/*!	States of a Brunel network: the four regimes of the phase diagram of the paper, and the two
+ * 	degenerate cases of a network which died out or which is saturated.	*/
+enum Regime {	Undetermined, 				/**<	Not enough activity recorded to decide.						*/
+				Quiescent, 					/**<	No more spikes in the network.								*/
+				Saturated, 					/**<	Neurons fire at the maximal rate allowed by refractoriness.	*/
+				SynchronousRegular, 		/**<	SR: synchronous population, regular neurons.				*/
+				SynchronousIrregularFast, 	/**<	SI fast: fast global oscillation, irregular neurons.		*/
+				SynchronousIrregularSlow, 	/**<	SI slow: slow global oscillation, irregular neurons.		*/
+				AsynchronousIrregular		/**<	AI: stationary population activity, irregular neurons.		*/
+			};
+
+//! RegimeClassifier class
+/*!	Labels the regime of a network from its running statistics, and decides when the simulation can stop.
+ * 
+ * 	The classifier is evaluated every window_bins bins of the statistics. The mean rate of each window is
+ * 	compared to the one of the previous window: when it has changed by less than tolerance during 
+ * 	stable_windows windows in a row, the statistics are considered converged and the regime is decided.
+ * 	A network without any spike or firing at the maximal rate is stopped as soon as it stays so during
+ * 	stable_windows windows. The first window contains the initial transient: it is a warm-up after which
+ * 	the statistics are reset, so that the regime is only decided from the activity which follows.
+ * 
+ * 	The regime is decided with the synchrony of the population, the mean coefficient of variation of 
+ * 	the interspike intervals and the dominant frequency of the population activity, when it is known.	*/
+class RegimeClassifier
+{
+	private:
+	
+	unsigned int window_bins_;		/**<	Number of bins of the statistics in a window.								*/
+	double tolerance_;				/**<	Relative change of the mean rate below which a window is stable.			*/
+	unsigned int stable_windows_;	/**<	Number of stable windows in a row needed to stop.							*/
+	
+	Regime regime_;					/**<	Regime of the network.														*/
+	bool finished_;					/**<	Set to true once the simulation can stop.									*/
+	unsigned int windows_;			/**<	Number of windows evaluated.												*/
+	unsigned int stable_;			/**<	Number of stable windows in a row.											*/
+	double rate_;					/**<	Mean rate during the last window, in Hz.									*/
+	unsigned int last_bins_;		/**<	Bins recorded by the statistics at the last evaluation.						*/
+	unsigned int last_steps_;		/**<	Time steps recorded by the statistics at the last evaluation.				*/
+	double last_spikes_;			/**<	Spikes per neuron recorded by the statistics at the last evaluation.		*/
+	
+	public:
+	
+	/*!	Synchrony above which the population is considered synchronous.	*/
+	static constexpr double SynchronyThreshold = 0.2;
+	/*!	Mean coefficient of variation below which neurons are considered regular.	*/
+	static constexpr double RegularityThreshold = 0.5;
+	/*!	Frequency (Hz) separating slow and fast global oscillations.	*/
+	static constexpr double FastOscillation = 60.0;
+	/*!	Mean rate (Hz) separating slow and fast oscillations when their frequency is unknown.	*/
+	static constexpr double FastRate = 20.0;
+	/*!	Fraction of the maximal rate 1/RefractoryPeriod above which the network is saturated.	*/
+	static constexpr double SaturationFraction = 0.9;
+	
+	//! Constructor
+	/*!	@param window_bins: Number of bins of the statistics in a window.
+	 * 	@param tolerance: Relative change of the mean rate below which a window is stable.
+	 * 	@param stable_windows: Number of stable windows in a row needed to stop.	*/
+	RegimeClassifier(unsigned int window_bins=10, double tolerance=0.05, unsigned int stable_windows=3);
+	
+/***************************************************/
+	/*	Getters	*/
+	//! Gets the regime of the network
+	/*!	@return Regime: Present regime, Undetermined until the simulation can stop.	*/
+	Regime getRegime() const;
+	//! Gets whether the simulation can stop
+	/*!	@return bool: true once the regime has been decided.	*/
+	bool isFinished() const;
+	//! Gets the mean rate during the last window
+	/*!	@return double: Mean rate in Hz.	*/
+	double getRate() const;
+	//! Gets the name of a regime
+	/*!	@param regime: Regime wanted.
+	 * 	@return string: Short name of the regime, as in the paper.	*/
+	static string getName(Regime const& regime);
+
+/***************************************************/
+	//!A public function taking the statistics and a double as parameters
+	/*!	Evaluates the network, if a window has been completed since the last evaluation. The statistics are
+	 * 	reset at the end of the warm-up window.
+	 * 	@param statistics: Running statistics of the network.
+	 * 	@param peak_frequency: Dominant frequency of the population activity in Hz, 0 if unknown.
+	 * 	@return bool: Whether the simulation can stop or not.	*/
+	bool update(SpikeStatistics& statistics, double const& peak_frequency=0.0);
+	
+	//!A public function taking the statistics and a double as parameters
+	/*!	Labels the regime of a network from its statistics, without any convergence test.
+	 * 	@param statistics: Statistics of the network.
+	 * 	@param peak_frequency: Dominant frequency of the population activity in Hz, 0 if unknown.
+	 * 	@return Regime: Regime of the network.	*/
+	static Regime classify(SpikeStatistics const& statistics, double const& peak_frequency=0.0);
+};
+
+#endif
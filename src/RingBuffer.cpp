@@ -0,0 +1,28 @@
+#include "RingBuffer.hpp"
+
+RingBuffer::RingBuffer(unsigned int max_delay)
+	:	slots_(depthFor(max_delay), 0.0), mask_(depthFor(max_delay)-1)
+{}
+
+RingBuffer::RingBuffer(vector<double> const& values)
+	:	slots_(depthFor(values.empty() ? 0 : values.size()-1), 0.0), mask_(slots_.size()-1)
+{	for(size_t i(0);i<values.size();++i)
+	{	slots_[i]=values[i];
+	}
+}
+
+/***************************************************/
+
+void RingBuffer::reset(unsigned int const& max_delay)
+{	slots_.assign(depthFor(max_delay), 0.0);
+	mask_=slots_.size()-1;
+}
+
+unsigned int RingBuffer::depthFor(unsigned int const& max_delay)
+{	/*	The slot of the time step being read must stay apart from the one of the latest arrival.	*/
+	unsigned int depth(1);
+	while(depth<max_delay+1)
+	{	depth*=2;
+	}
+	return depth;
+}
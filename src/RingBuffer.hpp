@@ -0,0 +1,57 @@
+#ifndef RINGBUFFER_H
+#define RINGBUFFER_H
+
+#include <vector>
+#include <math.h>
+#include "Utility/Constants.hpp"
+#include "Utility/Precision.hpp"
+
+using namespace std;
+
+//! RingBuffer class
+/*!	Ring buffer of the spikes received by a neuron, indexed by the global time step at which they arrive.
+ *
+ * 	The depth of the buffer is a power of 2, and a time step is turned into a slot by masking it, so that
+ * 	nobody has to advance indexes at each time step. A spike can be written for any time step up to
+ * 	getMaxDelay() steps after the one being read, which allows synapses of different delays.	*/
+class RingBuffer
+{
+	private:
+	vector<Accumulator> slots_;		/**<	Sum of the amplitudes arriving at each slot.		*/
+	unsigned int mask_;				/**<	Depth of the buffer - 1.							*/
+
+	public:
+	//! Constructor
+	/*!	@param max_delay: Largest delay in time steps of the spikes written in the buffer.	*/
+	explicit RingBuffer(unsigned int max_delay=delay_steps);
+
+	//! Constructor
+	/*!	@param values: Initial values of the first slots, the depth being rounded up to a power of 2.	*/
+	explicit RingBuffer(vector<double> const& values);
+
+/***************************************************/
+	/*	Getters	*/
+	//! Gets the number of slots of the buffer, a power of 2
+	unsigned int getDepth() const { return mask_+1; }
+	//! Gets the largest delay in time steps of the spikes which can be written
+	unsigned int getMaxDelay() const { return mask_; }
+
+/***************************************************/
+	//!	Gets the slot of a time step
+	/*!	@param step: Time step, or index of a slot.
+	 * 	@return Sum of the amplitudes arriving at the time step.	*/
+	Accumulator& operator[](unsigned int const& step) { return slots_[step&mask_]; }
+	Accumulator const& operator[](unsigned int const& step) const { return slots_[step&mask_]; }
+
+	//!A public function taking an unsigned int as parameter
+	/*!	Changes the depth of the buffer, emptying it.
+	 * 	@param max_delay: Largest delay in time steps of the spikes written in the buffer.	*/
+	void reset(unsigned int const& max_delay);
+
+	//!A public function taking an unsigned int as parameter
+	/*!	@param max_delay: Largest delay in time steps.
+	 * 	@return unsigned int: Depth of a buffer for this delay, the smallest power of 2 above it.	*/
+	static unsigned int depthFor(unsigned int const& max_delay);
+};
+
+#endif
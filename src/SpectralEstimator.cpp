@@ -0,0 +1,138 @@
+#include "SpectralEstimator.hpp"
+#include <cassert>
+
+SpectralEstimator::SpectralEstimator(unsigned int window, unsigned int bin_steps)
+	:	window_(1), bin_steps_(bin_steps), samples_count_(0), steps_(0), bin_spikes_(0.0), segments_(0)
+{	assert(window>1 && bin_steps_>0);
+	
+	/*	The window is rounded up to a power of 2 for the Fourier transform.	*/
+	while(window_<window)
+	{	window_*=2;
+	}
+	hop_=window_/2;
+	
+	samples_.assign(window_, 0.0);
+	fourier_.resize(window_);
+	spectrum_.assign(window_/2+1, 0.0);
+	
+	taper_.resize(window_);
+	for(unsigned int i(0);i<window_;++i)
+	{	taper_[i]=0.5*(1.0-cos(2.0*M_PI*i/window_));
+	}
+}
+
+/***************************************************/
+/*	Getters	*/
+
+unsigned int SpectralEstimator::getSegments() const
+{	return segments_;
+}
+
+unsigned int SpectralEstimator::getWindow() const
+{	return window_;
+}
+
+double SpectralEstimator::getFrequency(unsigned int const& idx) const
+{	/*	A window lasts window_*bin_steps_*dt milliseconds.	*/
+	return idx*1000.0/(window_*bin_steps_*dt);
+}
+
+vector<double> SpectralEstimator::getSpectrum() const
+{	vector<double> mean(spectrum_.size(), 0.0);
+	if(segments_>0)
+	{	for(size_t i(0);i<spectrum_.size();++i)
+		{	mean[i]=spectrum_[i]/segments_;
+		}
+	}
+	return mean;
+}
+
+double SpectralEstimator::getDominantFrequency(double const& min_frequency) const
+{	if(segments_==0)
+	{	return 0.0;
+	}
+	size_t best(0);
+	for(size_t i(1);i<spectrum_.size();++i)
+	{	if(getFrequency(i)>=min_frequency && (best==0 || spectrum_[i]>spectrum_[best]))
+		{	best=i;
+		}
+	}
+	return getFrequency(best);
+}
+
+/***************************************************/
+
+void SpectralEstimator::addStep(unsigned int const& spikes)
+{	bin_spikes_+=spikes;
+	if(++steps_<bin_steps_)
+	{	return;
+	}
+	
+	/*	The bin is complete and takes the place of the oldest one in the ring.	*/
+	samples_[samples_count_%window_]=bin_spikes_;
+	++samples_count_;
+	bin_spikes_=0.0;
+	steps_=0;
+	
+	/*	A new window is analysed each time hop_ bins have been added, once the ring is full.	*/
+	if(samples_count_>=window_ && (samples_count_-window_)%hop_==0)
+	{	addSegment();
+	}
+}
+
+void SpectralEstimator::reset()
+{	*this=SpectralEstimator(window_, bin_steps_);
+}
+
+void SpectralEstimator::addSegment()
+{	
+	/*	The oldest bin of the ring is the first one of the window. Its mean is removed, so that the DC
+	 * 	component does not leak into the low frequencies.	*/
+	unsigned int first(samples_count_%window_);
+	double mean(0.0);
+	for(unsigned int i(0);i<window_;++i)
+	{	mean+=samples_[i];
+	}
+	mean/=window_;
+	for(unsigned int i(0);i<window_;++i)
+	{	fourier_[i]=complex<double>((samples_[(first+i)%window_]-mean)*taper_[i], 0.0);
+	}
+	
+	fft(fourier_);
+	
+	for(size_t i(0);i<spectrum_.size();++i)
+	{	spectrum_[i]+=norm(fourier_[i]);
+	}
+	++segments_;
+}
+
+void SpectralEstimator::fft(vector<complex<double>>& values)
+{	size_t n(values.size());
+	
+	/*	Bit reversal permutation.	*/
+	for(size_t i(1), j(0);i<n;++i)
+	{	size_t bit(n>>1);
+		for(;j&bit;bit>>=1)
+		{	j^=bit;
+		}
+		j^=bit;
+		if(i<j)
+		{	swap(values[i], values[j]);
+		}
+	}
+	
+	/*	Butterflies of increasing length.	*/
+	for(size_t length(2);length<=n;length<<=1)
+	{	complex<double> root(polar(1.0, -2.0*M_PI/length));
+		for(size_t i(0);i<n;i+=length)
+		{	complex<double> w(1.0, 0.0);
+			for(size_t j(0);j<length/2;++j)
+			{	complex<double> u(values[i+j]);
+				complex<double> v(values[i+j+length/2]*w);
+				values[i+j]=u+v;
+				values[i+j+length/2]=u-v;
+				w*=root;
+			}
+		}
+	}
+}
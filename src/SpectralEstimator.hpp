@@ -0,0 +1,84 @@
+#ifndef SPECTRALESTIMATOR_H
+#define SPECTRALESTIMATOR_H
+
+#include <vector>
+#include <complex>
+#include <cmath>
+#include "Utility/Constants.hpp"
+
+using namespace std;
+
+//! SpectralEstimator class
+/*!	Streaming estimation of the power spectrum of the population activity, with the method of Welch.
+ * 
+ * 	The number of spikes of the network is summed in bins of bin_steps time steps. Each time hop new 
+ * 	bins are available, the last window bins are multiplied by a Hann window and Fourier transformed,
+ * 	and their periodogram is added to the running spectrum: consecutive windows overlap by half.
+ * 	Only the last window bins and the running spectrum are kept in memory.	*/
+class SpectralEstimator
+{
+	private:
+	
+	unsigned int window_;				/**<	Number of bins in a window, a power of 2.								*/
+	unsigned int bin_steps_;			/**<	Number of time steps in a bin.											*/
+	unsigned int hop_;					/**<	Number of new bins between two windows.									*/
+	
+	vector<double> samples_;			/**<	Ring of the last window bins.											*/
+	unsigned int samples_count_;		/**<	Total number of bins completed.											*/
+	unsigned int steps_;				/**<	Number of time steps in the present bin.								*/
+	double bin_spikes_;					/**<	Number of spikes in the present bin.									*/
+	
+	vector<double> taper_;				/**<	Hann window.															*/
+	vector<complex<double>> fourier_;	/**<	Work array of the Fourier transform.									*/
+	vector<double> spectrum_;			/**<	Sum of the periodograms of the windows, from 0 to the Nyquist frequency.	*/
+	unsigned int segments_;				/**<	Number of windows in the running spectrum.								*/
+	
+	//!A private function
+	/*!	Adds the periodogram of the last window to the running spectrum.	*/
+	void addSegment();
+	
+	public:
+	//! Constructor
+	/*!	The default values give a resolution of about 4 Hz up to 1 kHz.
+	 * 	@param window: Number of bins in a window, rounded up to a power of 2.
+	 * 	@param bin_steps: Number of time steps in a bin.	*/
+	SpectralEstimator(unsigned int window=512, unsigned int bin_steps=5);
+
+/***************************************************/
+	/*	Getters	*/
+	//! Gets the number of windows averaged
+	/*!	@return unsigned int: Number of windows.	*/
+	unsigned int getSegments() const;
+	//! Gets the size of a window
+	/*!	@return unsigned int: Number of bins in a window.	*/
+	unsigned int getWindow() const;
+	//! Gets the frequency of an index of the spectrum
+	/*!	@param idx: Index in the spectrum.
+	 * 	@return double: Frequency in Hz.	*/
+	double getFrequency(unsigned int const& idx) const;
+	//! Gets the running spectrum
+	/*!	@return Vector of window/2+1 mean powers, from 0 to the Nyquist frequency (empty spectrum if no
+	 * 	window has been completed).	*/
+	vector<double> getSpectrum() const;
+	//! Gets the dominant frequency of the population activity
+	/*!	@param min_frequency: Frequencies below are ignored, as the DC component is always the largest.
+	 * 	@return double: Frequency in Hz of the largest power, 0 if no window has been completed.	*/
+	double getDominantFrequency(double const& min_frequency=5.0) const;
+
+/***************************************************/
+	//!A public function taking an unsigned int as parameter
+	/*!	Records the number of spikes of a time step.
+	 * 	@param spikes: Number of spikes in the network during the time step.	*/
+	void addStep(unsigned int const& spikes);
+	
+	//!A public function
+	/*!	Resets the spectrum and the samples recorded.	*/
+	void reset();
+	
+	//!A public function taking a vector of complex numbers as parameter
+	/*!	In place iterative radix-2 fast Fourier transform.
+	 * 	@param values: Values to transform, their number must be a power of 2.	*/
+	static void fft(vector<complex<double>>& values);
+};
+
+#endif
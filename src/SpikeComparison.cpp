@@ -0,0 +1,175 @@
+#include "SpikeComparison.hpp"
+#include <cassert>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <algorithm>
+
+/*	Mean coefficient of variation of the interspike intervals of the trains having at least three spikes.	*/
+static double meanCV(SpikeTrains const& trains)
+{	double sum(0.0);
+	unsigned int counted(0);
+	for(size_t i(0);i<trains.size();++i)
+	{	vector<unsigned int> const& train(trains[i]);
+		if(train.size()<3)
+		{	continue;
+		}
+		double mean(double(train.back()-train.front())/(train.size()-1));
+		double variance(0.0);
+		for(size_t k(1);k<train.size();++k)
+		{	double interval(train[k]-train[k-1]);
+			variance+=(interval-mean)*(interval-mean);
+		}
+		variance/=(train.size()-2);
+		sum+=sqrt(variance)/mean;
+		++counted;
+	}
+	return counted>0 ? sum/counted : 0.0;
+}
+
+SpikeComparison::SpikeComparison(unsigned int window)
+	:	window_(window), reference_spikes_(0), test_spikes_(0), coincidences_(0), identical_neurons_(0),
+		first_divergence_(numeric_limits<unsigned int>::max()), reference_cv_(0.0), test_cv_(0.0)
+{}
+
+/***************************************************/
+/*	Getters	*/
+
+size_t SpikeComparison::getReferenceSpikes() const
+{	return reference_spikes_;
+}
+
+size_t SpikeComparison::getTestSpikes() const
+{	return test_spikes_;
+}
+
+size_t SpikeComparison::getCoincidences() const
+{	return coincidences_;
+}
+
+double SpikeComparison::getCoincidenceFactor() const
+{	if(reference_spikes_+test_spikes_==0)
+	{	return 1.0;
+	}
+	return 2.0*coincidences_/(reference_spikes_+test_spikes_);
+}
+
+size_t SpikeComparison::getIdenticalNeurons() const
+{	return identical_neurons_;
+}
+
+unsigned int SpikeComparison::getFirstDivergence() const
+{	return first_divergence_;
+}
+
+double SpikeComparison::getRateError() const
+{	if(reference_spikes_==0)
+	{	return test_spikes_==0 ? 0.0 : 1.0;
+	}
+	return (double(test_spikes_)-double(reference_spikes_))/reference_spikes_;
+}
+
+double SpikeComparison::getCVError() const
+{	return test_cv_-reference_cv_;
+}
+
+/***************************************************/
+
+void SpikeComparison::compare(SpikeTrains const& reference, SpikeTrains const& test)
+{	assert(reference.size()==test.size());
+
+	reference_spikes_=test_spikes_=coincidences_=identical_neurons_=0;
+	first_divergence_=numeric_limits<unsigned int>::max();
+
+	for(size_t i(0);i<reference.size();++i)
+	{	vector<unsigned int> const& a(reference[i]);
+		vector<unsigned int> const& b(test[i]);
+		reference_spikes_+=a.size();
+		test_spikes_+=b.size();
+
+		/*	The first spike which differs, or which is missing in one of the trains.	*/
+		size_t k(0);
+		while(k<a.size() && k<b.size() && a[k]==b[k])
+		{	++k;
+		}
+		if(k==a.size() && k==b.size())
+		{	++identical_neurons_;
+		} else {
+			unsigned int divergence(k==a.size() ? b[k] : (k==b.size() ? a[k] : min(a[k], b[k])));
+			first_divergence_=min(first_divergence_, divergence);
+		}
+
+		/*	Both trains are ordered: a spike is matched with the first spike of the other train close enough.	*/
+		size_t p(0), q(0);
+		while(p<a.size() && q<b.size())
+		{	if(a[p]+window_<b[q])
+			{	++p;
+			} else if(b[q]+window_<a[p])
+			{	++q;
+			} else {
+				++coincidences_;
+				++p;
+				++q;
+			}
+		}
+	}
+
+	reference_cv_=meanCV(reference);
+	test_cv_=meanCV(test);
+}
+
+void SpikeComparison::report(ostream& out) const
+{	out<<"spikes: "<<test_spikes_<<" (reference "<<reference_spikes_<<", relative error "<<getRateError()<<")"<<endl;
+	out<<"coincidence factor within "<<window_<<" steps: "<<getCoincidenceFactor()<<endl;
+	out<<"identical trains: "<<identical_neurons_<<endl;
+	if(first_divergence_==numeric_limits<unsigned int>::max())
+	{	out<<"first divergence: none"<<endl;
+	} else {
+		out<<"first divergence: "<<first_divergence_*dt<<" ms"<<endl;
+	}
+	out<<"mean CV: "<<test_cv_<<" (reference "<<reference_cv_<<")"<<endl;
+}
+
+SpikeTrains SpikeComparison::collect(Network const& network)
+{	View<Neuron* const> neurons(network.getNeurons());
+	SpikeTrains trains(neurons.size());
+	for(size_t i(0);i<neurons.size();++i)
+	{	SpikeHistory const& history(neurons[i]->getTime());
+		for(size_t k(0);k<history.size();++k)
+		{	trains[i].push_back(history.getStep(k));
+		}
+	}
+	return trains;
+}
+
+void SpikeComparison::write(SpikeTrains const& trains, string const& name)
+{
+	/*	The spikes of all neurons are sorted by time step, like in the spike file of a network.	*/
+	vector<pair<unsigned int, unsigned int>> spikes;
+	for(size_t i(0);i<trains.size();++i)
+	{	for(size_t k(0);k<trains[i].size();++k)
+		{	spikes.push_back(make_pair(trains[i][k], i));
+		}
+	}
+	sort(spikes.begin(), spikes.end());
+
+	ofstream file(name.c_str());
+	assert(!file.fail());
+	for(size_t s(0);s<spikes.size();++s)
+	{	file<<spikes[s].first<<" "<<spikes[s].second<<endl;
+	}
+}
+
+SpikeTrains SpikeComparison::read(string const& name)
+{	ifstream file(name.c_str());
+	assert(!file.fail());
+	SpikeTrains trains(TotalNeurons);
+	unsigned int step, neuron;
+	while(file>>step>>neuron)
+	{	if(neuron>=trains.size())
+		{	trains.resize(neuron+1);
+		}
+		trains[neuron].push_back(step);
+	}
+	return trains;
+}
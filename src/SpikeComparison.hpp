@@ -0,0 +1,87 @@
+#ifndef SPIKECOMPARISON_H
+#define SPIKECOMPARISON_H
+
+#include <vector>
+#include <string>
+#include <iostream>
+#include "Network.hpp"
+
+using namespace std;
+
+typedef vector<vector<unsigned int>> SpikeTrains; /**<	Time steps of the spikes of each neuron, in increasing order.	*/
+
+//! SpikeComparison class
+/*!	Compares the spike trains of a simulation with the ones of a reference simulation of the same network,
+ * 	for instance a simulation in single precision with the one in double precision.
+ *
+ * 	Two spikes of the same neuron coincide if they are at most window time steps apart, each spike being
+ * 	matched at most once. Chaotic networks diverge spike by spike as soon as one spike moves, so the
+ * 	comparison also reports the error on the population statistics, which are what matters once the
+ * 	trains have diverged.	*/
+class SpikeComparison
+{
+	private:
+
+	unsigned int window_;				/**<	Maximum distance in time steps of coinciding spikes.			*/
+	size_t reference_spikes_;			/**<	Number of spikes of the reference.								*/
+	size_t test_spikes_;				/**<	Number of spikes compared to the reference.						*/
+	size_t coincidences_;				/**<	Number of spikes coinciding with a spike of the reference.		*/
+	size_t identical_neurons_;			/**<	Number of neurons with exactly the same train.					*/
+	unsigned int first_divergence_;		/**<	First time step at which a train differs from the reference.	*/
+	double reference_cv_;				/**<	Mean coefficient of variation of the reference.					*/
+	double test_cv_;					/**<	Mean coefficient of variation compared to the reference.		*/
+
+	public:
+	//! Constructor
+	/*!	@param window: Maximum distance in time steps of coinciding spikes.	*/
+	explicit SpikeComparison(unsigned int window=0);
+
+/***************************************************/
+	/*	Getters	*/
+	//! Gets the number of spikes of the reference
+	size_t getReferenceSpikes() const;
+	//! Gets the number of spikes compared to the reference
+	size_t getTestSpikes() const;
+	//! Gets the number of spikes coinciding with a spike of the reference
+	size_t getCoincidences() const;
+	//! Gets the coincidence factor, 2*coincidences/(reference spikes+test spikes), 1 for identical trains
+	double getCoincidenceFactor() const;
+	//! Gets the number of neurons with exactly the same train as in the reference
+	size_t getIdenticalNeurons() const;
+	//! Gets the first time step at which a train differs from the reference, UINT_MAX if none does
+	unsigned int getFirstDivergence() const;
+	//! Gets the relative error on the number of spikes
+	double getRateError() const;
+	//! Gets the difference of mean coefficients of variation with the reference
+	double getCVError() const;
+
+/***************************************************/
+	//!A public function taking two sets of spike trains as parameters
+	/*!	Compares spike trains to the reference ones.
+	 * 	@param reference: Spike trains of the reference.
+	 * 	@param test: Spike trains compared, for the same neurons.	*/
+	void compare(SpikeTrains const& reference, SpikeTrains const& test);
+
+	//!A public function taking a stream as parameter
+	/*!	Writes the results of the comparison.
+	 * 	@param out: Stream written.	*/
+	void report(ostream& out) const;
+
+	//!A public function taking a network as parameter
+	/*!	@param network: Network simulated.
+	 * 	@return Spike trains of the neurons of the network, from their histories.	*/
+	static SpikeTrains collect(Network const& network);
+
+	//!A public function taking spike trains and a file name as parameters
+	/*!	Writes spike trains in a file, one line "step neuron" per spike, in increasing order of time steps.
+	 * 	@param trains: Spike trains.
+	 * 	@param name: Name of the file.	*/
+	static void write(SpikeTrains const& trains, string const& name);
+
+	//!A public function taking a file name as parameter
+	/*!	@param name: Name of a file written by write(), or the spike file of a network of all neurons.
+	 * 	@return Spike trains of the file.	*/
+	static SpikeTrains read(string const& name);
+};
+
+#endif
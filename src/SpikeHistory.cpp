@@ -0,0 +1,169 @@
+#include "SpikeHistory.hpp"
+#include <cassert>
+
+const size_t SpikeHistory::ChunkSize;
+
+/*	Set once the pool of the thread has been destroyed. It has no destructor, so it can still be read by
+ * 	the histories destroyed after the pool, for instance the ones of static networks.	*/
+static thread_local bool pool_destroyed(false);
+
+/*	Pool of the chunks not used by any history, one per thread so that the threads of a scheduler never
+ * 	wait for each other when their neurons spike. A chunk may be given back to another thread than the one
+ * 	which took it. The chunks are kept for the next simulation, and freed when the thread ends.	*/
+struct ChunkPool : public vector<unsigned int*>
+{	~ChunkPool()
+	{	for(size_t i(0);i<size();++i)
+		{	delete[] (*this)[i];
+		}
+		pool_destroyed=true;
+	}
+};
+static thread_local ChunkPool pool;
+
+static unsigned int* acquireChunk()
+{	if(pool_destroyed || pool.empty())
+	{	return new unsigned int[SpikeHistory::ChunkSize];
+	}
+	unsigned int* chunk(pool.back());
+	pool.pop_back();
+	return chunk;
+}
+
+static void releaseChunks(vector<unsigned int*>& chunks)
+{	if(pool_destroyed)
+	{	for(size_t i(0);i<chunks.size();++i)
+		{	delete[] chunks[i];
+		}
+	} else {
+		pool.insert(pool.end(), chunks.begin(), chunks.end());
+	}
+	chunks.clear();
+}
+
+SpikeHistory::SpikeHistory(size_t capacity)
+	:	size_(0), total_(0), capacity_(capacity), first_(0)
+{}
+
+SpikeHistory::SpikeHistory(SpikeHistory const& other)
+	:	size_(0), total_(0), capacity_(other.capacity_), first_(0)
+{	*this=other;
+}
+
+SpikeHistory& SpikeHistory::operator=(SpikeHistory const& other)
+{	if(this!=&other)
+	{	/*	The spikes are copied in order, the copy starting at position 0.	*/
+		clear();
+		capacity_=other.capacity_;
+		for(size_t i(0);i<other.size_;++i)
+		{	add(other.getStep(i));
+		}
+		total_=other.total_;
+	}
+	return *this;
+}
+
+SpikeHistory::~SpikeHistory()
+{	releaseChunks(chunks_);
+}
+
+/***************************************************/
+/*	Getters	*/
+
+size_t SpikeHistory::size() const
+{	return size_;
+}
+
+bool SpikeHistory::empty() const
+{	return size_==0;
+}
+
+size_t SpikeHistory::getTotal() const
+{	return total_;
+}
+
+size_t SpikeHistory::getCapacity() const
+{	return capacity_;
+}
+
+unsigned int SpikeHistory::getStep(size_t const& idx) const
+{	assert(idx<size_);
+	size_t position(first_+idx);
+	if(capacity_>0 && position>=capacity_)
+	{	position-=capacity_;
+	}
+	return at(position);
+}
+
+double SpikeHistory::operator[](size_t const& idx) const
+{	return getStep(idx)*dt;
+}
+
+SpikeHistory::const_iterator SpikeHistory::begin() const
+{	return const_iterator(this, 0);
+}
+
+SpikeHistory::const_iterator SpikeHistory::end() const
+{	return const_iterator(this, size_);
+}
+
+/***************************************************/
+/*	Setters	*/
+
+void SpikeHistory::setCapacity(size_t const& capacity)
+{	/*	The last spikes are copied in a new history with the wanted capacity.	*/
+	SpikeHistory bounded(capacity);
+	size_t kept(capacity>0 && capacity<size_ ? capacity : size_);
+	for(size_t i(size_-kept);i<size_;++i)
+	{	bounded.add(getStep(i));
+	}
+	bounded.total_=total_;
+	*this=bounded;
+}
+
+/***************************************************/
+
+unsigned int& SpikeHistory::at(size_t const& position) const
+{	return chunks_[position/ChunkSize][position%ChunkSize];
+}
+
+void SpikeHistory::add(unsigned int const& step)
+{	++total_;
+	
+	/*	A full bounded history overwrites its oldest spike.	*/
+	if(capacity_>0 && size_==capacity_)
+	{	at(first_)=step;
+		if(++first_==capacity_)
+		{	first_=0;
+		}
+		return;
+	}
+	
+	if(size_==chunks_.size()*ChunkSize)
+	{	chunks_.push_back(acquireChunk());
+	}
+	at(size_)=step;
+	++size_;
+}
+
+void SpikeHistory::clear()
+{	releaseChunks(chunks_);
+	size_=0;
+	total_=0;
+	first_=0;
+}
+
+bool SpikeHistory::operator==(SpikeHistory const& other) const
+{	if(size_!=other.size_)
+	{	return false;
+	}
+	for(size_t i(0);i<size_;++i)
+	{	if(getStep(i)!=other.getStep(i))
+		{	return false;
+		}
+	}
+	return true;
+}
+
+bool SpikeHistory::operator!=(SpikeHistory const& other) const
+{	return !(*this==other);
+}
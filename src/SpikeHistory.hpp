@@ -0,0 +1,119 @@
+#ifndef SPIKEHISTORY_H
+#define SPIKEHISTORY_H
+
+#include <vector>
+#include <cstddef>
+#include <iterator>
+#include <cmath>
+#include "Utility/Constants.hpp"
+
+using namespace std;
+
+//! SpikeHistory class
+/*!	Record of the spikes of a neuron, stored as time steps in chunks of ChunkSize integers. 
+ * 
+ * 	Chunks are taken from a pool of the calling thread and given back to the pool of the thread which
+ * 	clears or destroys the history, so that recording a spike never moves the spikes already recorded and
+ * 	rarely allocates memory, without any lock. 
+ * 
+ * 	A capacity can be set to only keep the last spikes: the history then becomes a ring of capacity 
+ * 	spikes, and the oldest spike is overwritten by each new one. The total number of spikes recorded
+ * 	is still counted.	*/
+class SpikeHistory
+{
+	public:
+	
+	static const size_t ChunkSize = 256;	/**<	Number of spikes in a chunk.	*/
+	
+	//! Iterator on the spike times of a history
+	class const_iterator : public iterator<random_access_iterator_tag, double, ptrdiff_t, void, double>
+	{	
+		private:
+		SpikeHistory const* history_;	/**<	History iterated.				*/
+		size_t idx_;					/**<	Index of the present spike.		*/
+		
+		public:
+		const_iterator(SpikeHistory const* history, size_t idx) : history_(history), idx_(idx) {}
+		double operator*() const { return (*history_)[idx_]; }
+		const_iterator& operator++() { ++idx_; return *this; }
+		const_iterator operator++(int) { const_iterator old(*this); ++idx_; return old; }
+		ptrdiff_t operator-(const_iterator const& other) const { return idx_-other.idx_; }
+		bool operator==(const_iterator const& other) const { return idx_==other.idx_; }
+		bool operator!=(const_iterator const& other) const { return idx_!=other.idx_; }
+	};
+	
+	private:
+	
+	vector<unsigned int*> chunks_;	/**<	Chunks holding the time steps of the spikes.							*/
+	size_t size_;					/**<	Number of spikes stored.												*/
+	size_t total_;					/**<	Number of spikes recorded since the history was cleared.				*/
+	size_t capacity_;				/**<	Maximal number of spikes stored, 0 if the history is unbounded.			*/
+	size_t first_;					/**<	Position of the oldest spike stored (only moves if bounded).			*/
+	
+	//!A private function taking an index as parameter
+	/*!	@param position: Position of a spike in the storage.
+	 * 	@return Reference on the time step stored at that position.	*/
+	unsigned int& at(size_t const& position) const;
+	
+	public:
+	//! Constructor
+	/*!	@param capacity: Maximal number of spikes stored, 0 to keep them all.	*/
+	explicit SpikeHistory(size_t capacity=0);
+	
+	//! Copy constructor
+	SpikeHistory(SpikeHistory const& other);
+	
+	//! Assignment operator
+	SpikeHistory& operator=(SpikeHistory const& other);
+	
+	//! Destructor
+	/*!	Gives the chunks back to the pool.	*/
+	~SpikeHistory();
+
+/***************************************************/
+	/*	Getters	*/
+	//! Gets the number of spikes stored
+	size_t size() const;
+	//! Gets whether no spike is stored
+	bool empty() const;
+	//! Gets the number of spikes recorded, including the ones overwritten
+	size_t getTotal() const;
+	//! Gets the maximal number of spikes stored
+	/*!	@return Capacity, 0 if the history is unbounded.	*/
+	size_t getCapacity() const;
+	//! Gets the time step of a spike
+	/*!	@param idx: Index of the spike, 0 being the oldest one stored.
+	 * 	@return unsigned int: Time step of the spike.	*/
+	unsigned int getStep(size_t const& idx) const;
+	//! Gets the time of a spike
+	/*!	@param idx: Index of the spike, 0 being the oldest one stored.
+	 * 	@return double: Time of the spike in milliseconds.	*/
+	double operator[](size_t const& idx) const;
+	//! Gets an iterator on the time of the oldest spike stored
+	const_iterator begin() const;
+	//! Gets an iterator past the time of the last spike
+	const_iterator end() const;
+	
+/***************************************************/
+	/*	Setters	*/
+	//! Sets the maximal number of spikes stored
+	/*!	Only the last spikes are kept if there are more than capacity.
+	 * 	@param capacity: New capacity, 0 to keep all spikes.	*/
+	void setCapacity(size_t const& capacity);
+
+/***************************************************/
+	//!A public function taking an unsigned int as parameter
+	/*!	Records a spike.
+	 * 	@param step: Time step of the spike.	*/
+	void add(unsigned int const& step);
+	
+	//!A public function
+	/*!	Removes all spikes and gives the chunks back to the pool.	*/
+	void clear();
+	
+	//! Compares the spikes stored in two histories
+	bool operator==(SpikeHistory const& other) const;
+	bool operator!=(SpikeHistory const& other) const;
+};
+
+#endif
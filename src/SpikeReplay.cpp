@@ -0,0 +1,124 @@
+#include "SpikeReplay.hpp"
+#include <cassert>
+#include <fstream>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <algorithm>
+
+constexpr uint32_t SpikeReplay::Magic;
+
+SpikeReplay::SpikeReplay(string const& path, double amplitude)
+	:	SpikeSource(Projection(readSources(path)), amplitude), data_(nullptr), size_(0), header_(nullptr),
+		neurons_(nullptr), offsets_(nullptr), start_(0)
+{	map(path);
+}
+
+SpikeReplay::SpikeReplay(string const& path, unsigned int neurons, unsigned int connections, unsigned int seed, double amplitude)
+	:	SpikeSource(Projection(neurons, readSources(path), connections, CounterRandom(seed)), amplitude), data_(nullptr),
+		size_(0), header_(nullptr), neurons_(nullptr), offsets_(nullptr), start_(0)
+{	map(path);
+}
+
+SpikeReplay::~SpikeReplay()
+{	munmap(data_, size_);
+}
+
+/***************************************************/
+/*	Getters	*/
+
+unsigned int SpikeReplay::getSources() const
+{	return header_->sources;
+}
+
+unsigned int SpikeReplay::getSteps() const
+{	return header_->steps;
+}
+
+size_t SpikeReplay::getEvents() const
+{	return header_->events;
+}
+
+/***************************************************/
+
+void SpikeReplay::reset(unsigned int const& time)
+{	start_=time;
+}
+
+View<unsigned int const> SpikeReplay::fire(unsigned int const& time)
+{	if(time<start_ || time-start_>=header_->steps)
+	{	return View<unsigned int const>();
+	}
+	unsigned int step(time-start_);
+	return View<unsigned int const>(neurons_+offsets_[step], offsets_[step+1]-offsets_[step]);
+}
+
+size_t SpikeReplay::convert(istream& text, string const& path)
+{	ofstream binary(path.c_str(), ios::binary | ios::trunc);
+	assert(!binary.fail());
+	Header header = {Magic, 0, 0, 0, 0};
+	binary.write(reinterpret_cast<char const*>(&header), sizeof(header));
+
+	/*	The neurons are written as they are read, and the first spike of each step is kept.	*/
+	vector<uint64_t> offsets(1, 0);
+	unsigned int step, neuron;
+	while(text>>step>>neuron)
+	{	assert(step+1>=offsets.size());
+		while(offsets.size()<=step)
+		{	offsets.push_back(header.events);
+		}
+		uint32_t word(neuron);
+		binary.write(reinterpret_cast<char const*>(&word), sizeof(word));
+		++header.events;
+		header.sources=max<uint32_t>(header.sources, neuron+1);
+	}
+	header.steps=offsets.size()-1;
+	if(header.events>0)
+	{	++header.steps;
+	}
+	offsets.resize(header.steps+1, header.events);
+	
+	char padding[8] = {0};
+	binary.write(padding, getOffsetsPosition(header.events)-(sizeof(header)+4*header.events));
+	binary.write(reinterpret_cast<char const*>(offsets.data()), offsets.size()*sizeof(uint64_t));
+	binary.seekp(0);
+	binary.write(reinterpret_cast<char const*>(&header), sizeof(header));
+	assert(!binary.fail());
+	return header.events;
+}
+
+size_t SpikeReplay::getOffsetsPosition(uint64_t const& events)
+{	return (sizeof(Header)+4*events+7)/8*8;
+}
+
+unsigned int SpikeReplay::readSources(string const& path)
+{	ifstream binary(path.c_str(), ios::binary);
+	Header header;
+	binary.read(reinterpret_cast<char*>(&header), sizeof(header));
+	assert(!binary.fail() && header.magic==Magic);
+	return header.sources;
+}
+
+void SpikeReplay::map(string const& path)
+{	int file(open(path.c_str(), O_RDONLY));
+	assert(file>=0);
+	struct stat status;
+	fstat(file, &status);
+	size_=status.st_size;
+	data_=mmap(nullptr, size_, PROT_READ, MAP_SHARED, file, 0);
+	close(file);
+	assert(data_!=MAP_FAILED);
+	
+	/*	The steps are replayed in order, so the kernel reads ahead and drops the pages already replayed.	*/
+	madvise(data_, size_, MADV_SEQUENTIAL);
+	
+	static_assert(sizeof(Header)==24, "The header of a binary spike file has no padding");
+	char const* bytes(static_cast<char const*>(data_));
+	header_=reinterpret_cast<Header const*>(bytes);
+	assert(size_>=sizeof(Header) && header_->magic==Magic);
+	neurons_=reinterpret_cast<uint32_t const*>(bytes+sizeof(Header));
+	offsets_=reinterpret_cast<uint64_t const*>(bytes+getOffsetsPosition(header_->events));
+	assert(size_==getOffsetsPosition(header_->events)+(header_->steps+1)*sizeof(uint64_t));
+}
@@ -0,0 +1,111 @@
+#ifndef SPIKEREPLAY_H
+#define SPIKEREPLAY_H
+
+#include <string>
+#include <iostream>
+#include <cstdint>
+#include "SpikeSource.hpp"
+#include "Utility/Constants.hpp"
+
+using namespace std;
+
+//! SpikeReplay class
+/*!	Replays recorded spike trains, for instance the ones of a previous simulation, as input of a network.
+ * 	The spikes are read from a binary file mapped in memory: the neurons spiking at each step are contiguous
+ * 	and given to the network without being copied, and only the pages of the steps replayed are read, so a
+ * 	recording larger than the memory can be replayed.
+ *
+ * 	The binary file is written by convert from a text file of "step neuron" lines sorted by step, such as
+ * 	the jupyterplot.txt file of a network of all 12500 neurons. It contains a header, the recorded neurons
+ * 	spiking at each step, step after step, then the index of the first spike of each step.	*/
+class SpikeReplay : public SpikeSource
+{
+	public:
+	//! Header of a binary spike file
+	struct Header
+	{	uint32_t magic;		/**<	SpikeReplay::Magic.							*/
+		uint32_t sources;	/**<	Number of recorded neurons.					*/
+		uint32_t steps;		/**<	Number of time steps recorded.				*/
+		uint32_t reserved;	/**<	Padding, 0.									*/
+		uint64_t events;	/**<	Number of spikes recorded.					*/
+	};
+
+	private:
+	void* data_;					/**<	Mapping of the file.												*/
+	size_t size_;					/**<	Size of the mapping in bytes.										*/
+	Header const* header_;			/**<	Header of the file.													*/
+	uint32_t const* neurons_;		/**<	Recorded neurons spiking at each step, step after step.				*/
+	uint64_t const* offsets_;		/**<	First spike of each step in neurons_, followed by the number of spikes.	*/
+	unsigned int start_;			/**<	Time step of the network at which the first recorded step is replayed.	*/
+
+	public:
+	static constexpr uint32_t Magic=0x53504b31;	/**<	Identifier of the binary spike files, "SPK1".	*/
+
+	//! Constructor
+	/*!	Replays the spikes of each recorded neuron to the neuron of the same index.
+	 * 	@param path: Binary spike file, written by convert.
+	 * 	@param amplitude: Amplitude of the spikes received, in mV.	*/
+	explicit SpikeReplay(string const& path, double amplitude=Amplitude);
+
+	//! Constructor
+	/*!	Replays the spikes of the recorded neurons through a random projection.
+	 * 	@param path: Binary spike file, written by convert.
+	 * 	@param neurons: Number of neurons driven.
+	 * 	@param connections: Number of recorded neurons linked to each neuron, drawn with repetitions.
+	 * 	@param seed: Seed of the links.
+	 * 	@param amplitude: Amplitude of the spikes received, in mV.	*/
+	SpikeReplay(string const& path, unsigned int neurons, unsigned int connections, unsigned int seed, double amplitude=Amplitude);
+
+	SpikeReplay(SpikeReplay const&) = delete;
+	SpikeReplay& operator=(SpikeReplay const&) = delete;
+
+	//! Destructor
+	/*!	Unmaps the file.	*/
+	~SpikeReplay();
+
+/***************************************************/
+	/*	Getters	*/
+	//! Gets the number of recorded neurons
+	unsigned int getSources() const;
+	//! Gets the number of time steps recorded
+	unsigned int getSteps() const;
+	//! Gets the number of spikes recorded
+	size_t getEvents() const;
+
+/***************************************************/
+	//!A public function taking a time step as parameter
+	/*!	@param time: Time step of the network at which the first recorded step is replayed.	*/
+	void reset(unsigned int const& time) override;
+
+	//!A public function taking a time step as parameter
+	/*!	@param time: Time step of the network.
+	 * 	@return View on the recorded neurons spiking at this step, in the mapping of the file.	*/
+	View<unsigned int const> fire(unsigned int const& time) override;
+
+	//!A public function taking a text stream and a file name as parameters
+	/*!	Converts spikes from text to a binary spike file, streaming them so that the recording does not have
+	 * 	to fit in memory: only the index of the first spike of each step is kept until the end.
+	 * 	@param text: Lines "step neuron" sorted by step.
+	 * 	@param path: Binary spike file written.
+	 * 	@return size_t: Number of spikes converted.	*/
+	static size_t convert(istream& text, string const& path);
+
+	//!A public function taking a number of spikes as parameter
+	/*!	@param events: Number of spikes of a binary spike file.
+	 * 	@return size_t: Position of the index of the first spike of each step in the file, after the neurons
+	 * 	spiking, aligned on 8 bytes.	*/
+	static size_t getOffsetsPosition(uint64_t const& events);
+
+	private:
+	//!A private function taking a file name as parameter
+	/*!	@param path: Binary spike file.
+	 * 	@return unsigned int: Number of recorded neurons, from the header of the file.	*/
+	static unsigned int readSources(string const& path);
+
+	//!A private function taking a file name as parameter
+	/*!	Maps the file and checks its layout.
+	 * 	@param path: Binary spike file.	*/
+	void map(string const& path);
+};
+
+#endif
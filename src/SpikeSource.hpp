@@ -0,0 +1,46 @@
+#ifndef SPIKESOURCE_H
+#define SPIKESOURCE_H
+
+#include "Projection.hpp"
+#include "Utility/View.hpp"
+
+using namespace std;
+
+//! SpikeSource class
+/*!	Source of spikes from outside a network, delivered through a projection to its neurons during the
+ * 	time step at which they occur. A source is fired once per time step, with increasing time steps.	*/
+class SpikeSource
+{
+	protected:
+	Projection projection_;		/**<	Links from the sources to the neurons.		*/
+	double amplitude_;			/**<	Amplitude of the spikes received, in mV.	*/
+
+	public:
+	//! Constructor
+	/*!	@param projection: Links from the sources to the neurons.
+	 * 	@param amplitude: Amplitude of the spikes received, in mV.	*/
+	SpikeSource(Projection const& projection, double amplitude) : projection_(projection), amplitude_(amplitude) {}
+
+	//! Destructor
+	virtual ~SpikeSource() {}
+
+/***************************************************/
+	/*	Getters	*/
+	//! Gets the links from the sources to the neurons
+	Projection const& getProjection() const { return projection_; }
+	//! Gets the amplitude of the spikes received
+	double getAmplitude() const { return amplitude_; }
+
+/***************************************************/
+	//!A public function taking a time step as parameter
+	/*!	Starts the spikes of the source at a time step.
+	 * 	@param time: Time step of the network.	*/
+	virtual void reset(unsigned int const& time) = 0;
+
+	//!A public function taking a time step as parameter
+	/*!	@param time: Time step, at least the one of the last call.
+	 * 	@return View on the sources spiking during this time step, valid until the next call.	*/
+	virtual View<unsigned int const> fire(unsigned int const& time) = 0;
+};
+
+#endif
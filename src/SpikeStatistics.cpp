@@ -0,0 +1,163 @@
+#include "SpikeStatistics.hpp"
+#include <cassert>
+
+SpikeStatistics::SpikeStatistics(unsigned int neurons, unsigned int excitatory, unsigned int bin_steps)
+	:	excitatory_(excitatory), bin_steps_(bin_steps), steps_(0), bins_(0), spikes_(neurons), last_spike_(neurons),
+		isi_mean_(neurons), isi_m2_(neurons), bin_spikes_(neurons), count_mean_(neurons), count_m2_(neurons),
+		population_spikes_(0), population_mean_(0.0), population_m2_(0.0)
+{	assert(excitatory_<=neurons);
+	assert(bin_steps_>0);
+}
+
+/***************************************************/
+/*	Getters	*/
+
+unsigned int SpikeStatistics::getSteps() const
+{	return steps_;
+}
+
+unsigned int SpikeStatistics::getBins() const
+{	return bins_;
+}
+
+unsigned int SpikeStatistics::getSpikes(unsigned int const& neuron) const
+{	return spikes_[neuron];
+}
+
+double SpikeStatistics::getMeanRate(bool const& excitatory) const
+{	
+	/*	The excitatory population is [0, excitatory_[, the inhibitory one is the rest of the network.	*/
+	size_t begin(excitatory ? 0 : excitatory_);
+	size_t end(excitatory ? excitatory_ : spikes_.size());
+	if(end==begin || steps_==0)
+	{	return 0.0;
+	}
+	
+	double total(0.0);
+	for(size_t i(begin);i<end;++i)
+	{	total+=spikes_[i];
+	}
+	
+	/*	Conversion from spikes per time step to spikes per second.	*/
+	return total*1000.0/((end-begin)*steps_*dt);
+}
+
+double SpikeStatistics::getMeanRate() const
+{	if(spikes_.empty() || steps_==0)
+	{	return 0.0;
+	}
+	double total(0.0);
+	for(size_t i(0);i<spikes_.size();++i)
+	{	total+=spikes_[i];
+	}
+	return total*1000.0/(spikes_.size()*steps_*dt);
+}
+
+double SpikeStatistics::getCV(unsigned int const& neuron) const
+{	
+	/*	At least two intervals are needed for a variance.	*/
+	if(spikes_[neuron]<3 || isi_mean_[neuron]==0.0)
+	{	return 0.0;
+	}
+	double variance(isi_m2_[neuron]/(spikes_[neuron]-2));
+	return sqrt(variance)/isi_mean_[neuron];
+}
+
+double SpikeStatistics::getMeanCV() const
+{	double total(0.0);
+	unsigned int counted(0);
+	for(size_t i(0);i<spikes_.size();++i)
+	{	if(spikes_[i]>=3)
+		{	total+=getCV(i);
+			++counted;
+		}
+	}
+	return counted==0 ? 0.0 : total/counted;
+}
+
+double SpikeStatistics::getFanoFactor(unsigned int const& neuron) const
+{	if(bins_<2 || count_mean_[neuron]==0.0)
+	{	return 0.0;
+	}
+	return (count_m2_[neuron]/(bins_-1))/count_mean_[neuron];
+}
+
+double SpikeStatistics::getMeanFanoFactor() const
+{	double total(0.0);
+	unsigned int counted(0);
+	for(size_t i(0);i<spikes_.size();++i)
+	{	if(count_mean_[i]>0.0)
+		{	total+=getFanoFactor(i);
+			++counted;
+		}
+	}
+	return counted==0 ? 0.0 : total/counted;
+}
+
+double SpikeStatistics::getSynchrony() const
+{	if(bins_<2 || spikes_.empty())
+	{	return 0.0;
+	}
+	
+	/*	Mean variance of the activity of single neurons.	*/
+	double single(0.0);
+	for(size_t i(0);i<count_m2_.size();++i)
+	{	single+=count_m2_[i];
+	}
+	single/=count_m2_.size();
+	if(single==0.0)
+	{	return 0.0;
+	}
+	
+	/*	The population activity is the mean spike count of the neurons in a bin.	*/
+	double population(population_m2_/(static_cast<double>(spikes_.size())*spikes_.size()));
+	return sqrt(population/single);
+}
+
+/***************************************************/
+
+void SpikeStatistics::addSpike(unsigned int const& neuron, unsigned int const& step)
+{	
+	/*	The interspike interval is accumulated with the algorithm of Welford, which only needs the
+	 * 	running mean and sum of squared deviations.	*/
+	if(spikes_[neuron]>0)
+	{	double interval(step-last_spike_[neuron]);
+		unsigned int intervals(spikes_[neuron]);
+		double delta(interval-isi_mean_[neuron]);
+		isi_mean_[neuron]+=delta/intervals;
+		isi_m2_[neuron]+=delta*(interval-isi_mean_[neuron]);
+	}
+	last_spike_[neuron]=step;
+	++spikes_[neuron];
+	
+	++bin_spikes_[neuron];
+	++population_spikes_;
+}
+
+bool SpikeStatistics::endStep()
+{	++steps_;
+	if(steps_%bin_steps_!=0)
+	{	return false;
+	}
+	
+	/*	The bin is complete: the spike counts of each neuron and of the population are accumulated
+	 * 	the same way as the interspike intervals.	*/
+	++bins_;
+	for(size_t i(0);i<bin_spikes_.size();++i)
+	{	double delta(bin_spikes_[i]-count_mean_[i]);
+		count_mean_[i]+=delta/bins_;
+		count_m2_[i]+=delta*(bin_spikes_[i]-count_mean_[i]);
+		bin_spikes_[i]=0;
+	}
+	
+	double delta(population_spikes_-population_mean_);
+	population_mean_+=delta/bins_;
+	population_m2_+=delta*(population_spikes_-population_mean_);
+	population_spikes_=0;
+	
+	return true;
+}
+
+void SpikeStatistics::reset()
+{	*this=SpikeStatistics(spikes_.size(), excitatory_, bin_steps_);
+}
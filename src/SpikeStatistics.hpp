@@ -0,0 +1,101 @@
+#ifndef SPIKESTATISTICS_H
+#define SPIKESTATISTICS_H
+
+#include <vector>
+#include <cmath>
+#include "Utility/Constants.hpp"
+
+using namespace std;
+
+//! SpikeStatistics class
+/*!	Online analysis of the spikes of a network. The statistics are updated at each spike and at each
+ * 	time step, without keeping the spike times: the memory needed only grows with the number of neurons.
+ * 
+ * 	Spikes are also counted in bins of bin_steps time steps, from which the Fano factor of each neuron
+ * 	and the synchrony of the population are computed. The synchrony measure is the one of Golomb: the 
+ * 	square root of the variance of the population activity divided by the mean variance of the activity
+ * 	of single neurons. It is 1 for a fully synchronous network and goes down as 1/sqrt(N) for independent
+ * 	neurons.	*/
+class SpikeStatistics
+{
+	private:
+	
+	unsigned int excitatory_;			/**<	Neurons with an index below excitatory_ are excitatory.						*/
+	unsigned int bin_steps_;			/**<	Number of time steps in a bin.												*/
+	unsigned int steps_;				/**<	Number of time steps recorded.												*/
+	unsigned int bins_;					/**<	Number of complete bins recorded.											*/
+	
+	vector<unsigned int> spikes_;		/**<	Total number of spikes of each neuron.										*/
+	vector<unsigned int> last_spike_;	/**<	Time step of the last spike of each neuron.									*/
+	vector<double> isi_mean_;			/**<	Running mean of the interspike intervals of each neuron.					*/
+	vector<double> isi_m2_;				/**<	Running sum of squared deviations of the interspike intervals.				*/
+	
+	vector<unsigned int> bin_spikes_;	/**<	Spikes of each neuron in the present bin.									*/
+	vector<double> count_mean_;			/**<	Running mean of the spike counts per bin of each neuron.					*/
+	vector<double> count_m2_;			/**<	Running sum of squared deviations of the spike counts per bin.				*/
+	unsigned int population_spikes_;	/**<	Spikes of the whole population in the present bin.							*/
+	double population_mean_;			/**<	Running mean of the population activity per bin.							*/
+	double population_m2_;				/**<	Running sum of squared deviations of the population activity.				*/
+	
+	public:
+	//! Constructor
+	/*!	@param neurons: Number of neurons analysed.
+	 * 	@param excitatory: Number of excitatory neurons, which are the first ones of the network.
+	 * 	@param bin_steps: Number of time steps in a bin, 10 ms by default.	*/
+	SpikeStatistics(unsigned int neurons, unsigned int excitatory, unsigned int bin_steps=100);
+
+/***************************************************/
+	/*	Getters	*/
+	//! Gets the number of time steps recorded
+	/*!	@return unsigned int: Number of time steps.	*/
+	unsigned int getSteps() const;
+	//! Gets the number of complete bins recorded
+	/*!	@return unsigned int: Number of bins.	*/
+	unsigned int getBins() const;
+	//! Gets the number of spikes of a neuron
+	/*!	@param neuron: Index of the neuron.
+	 * 	@return unsigned int: Number of spikes.	*/
+	unsigned int getSpikes(unsigned int const& neuron) const;
+	//! Gets the mean firing rate of a population
+	/*!	@param excitatory: true for the excitatory population, false for the inhibitory one.
+	 * 	@return double: Mean firing rate in Hz, 0 if the population is empty.	*/
+	double getMeanRate(bool const& excitatory) const;
+	//! Gets the mean firing rate of the whole network
+	/*!	@return double: Mean firing rate in Hz.	*/
+	double getMeanRate() const;
+	//! Gets the coefficient of variation of the interspike intervals of a neuron
+	/*!	@param neuron: Index of the neuron.
+	 * 	@return double: Coefficient of variation, 0 if the neuron has spiked less than 3 times.	*/
+	double getCV(unsigned int const& neuron) const;
+	//! Gets the mean coefficient of variation of the neurons having spiked at least 3 times
+	/*!	@return double: Mean coefficient of variation.	*/
+	double getMeanCV() const;
+	//! Gets the Fano factor of the spike counts per bin of a neuron
+	/*!	@param neuron: Index of the neuron.
+	 * 	@return double: Fano factor, 0 if the neuron has not spiked or less than 2 bins are complete.	*/
+	double getFanoFactor(unsigned int const& neuron) const;
+	//! Gets the mean Fano factor of the neurons having spiked
+	/*!	@return double: Mean Fano factor.	*/
+	double getMeanFanoFactor() const;
+	//! Gets the synchrony of the population
+	/*!	@return double: Synchrony measure between 0 and 1.	*/
+	double getSynchrony() const;
+	
+/***************************************************/
+	//!A public function taking two unsigned int as parameters
+	/*!	Records a spike.
+	 * 	@param neuron: Index of the neuron which spiked.
+	 * 	@param step: Time step of the spike.	*/
+	void addSpike(unsigned int const& neuron, unsigned int const& step);
+	
+	//!A public function
+	/*!	Ends a time step, and closes the present bin if it is complete.
+	 * 	@return bool: Whether a bin has been completed or not.	*/
+	bool endStep();
+	
+	//!A public function
+	/*!	Resets all statistics, keeping the number of neurons.	*/
+	void reset();
+};
+
+#endif
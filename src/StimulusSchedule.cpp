@@ -0,0 +1,124 @@
+#include "StimulusSchedule.hpp"
+#include <cassert>
+#include <algorithm>
+
+StimulusSchedule::StimulusSchedule()
+	:	compiled_(true), next_(0)
+{}
+
+/***************************************************/
+/*	Getters	*/
+
+size_t StimulusSchedule::getEvents() const
+{	return events_.size();
+}
+
+double StimulusSchedule::getCurrent(unsigned int const& neuron) const
+{	return neuron<totals_.size() ? totals_[neuron] : 0.0;
+}
+
+/***************************************************/
+
+unsigned int StimulusSchedule::addGroup(vector<unsigned int> const& neurons)
+{	groups_.push_back(neurons);
+	return groups_.size()-1;
+}
+
+unsigned int StimulusSchedule::addGroup(unsigned int const& first, unsigned int const& last)
+{	assert(first<=last);
+	vector<unsigned int> neurons;
+	for(unsigned int i(first);i<last;++i)
+	{	neurons.push_back(i);
+	}
+	return addGroup(neurons);
+}
+
+void StimulusSchedule::addSteps(unsigned int const& group, vector<pair<double, double>> const& changes)
+{	unsigned int stimulus(addStimulus(group));
+	for(size_t k(0);k<changes.size();++k)
+	{	assert(k==0 || changes[k].first>=changes[k-1].first);
+		addEvent(stimulus, toStep(changes[k].first), changes[k].second);
+	}
+}
+
+void StimulusSchedule::addRamp(unsigned int const& group, double const& start, double const& stop, double const& from, double const& to)
+{	unsigned int stimulus(addStimulus(group)), first(toStep(start)), last(toStep(stop));
+	assert(first<last);
+	for(unsigned int step(first);step<last;++step)
+	{	addEvent(stimulus, step, from+(to-from)*(step-first)/(last-first));
+	}
+	addEvent(stimulus, last, 0.0);
+}
+
+void StimulusSchedule::addSine(unsigned int const& group, double const& start, double const& stop, double const& offset,
+								double const& amplitude, double const& frequency)
+{	unsigned int stimulus(addStimulus(group)), first(toStep(start)), last(toStep(stop));
+	for(unsigned int step(first);step<last;++step)
+	{	addEvent(stimulus, step, offset+amplitude*sin(2.0*M_PI*frequency*(step-first)*dt/1000.0));
+	}
+	addEvent(stimulus, last, 0.0);
+}
+
+void StimulusSchedule::addNoise(unsigned int const& group, double const& start, double const& stop, double const& mean,
+								double const& sigma, unsigned int const& seed)
+{	unsigned int stimulus(addStimulus(group)), first(toStep(start)), last(toStep(stop));
+	CounterRandom random(seed);
+	for(unsigned int step(first);step<last;++step)
+	{	addEvent(stimulus, step, mean+sigma*random.gaussian(StimulusStream, stimulus, step));
+	}
+	addEvent(stimulus, last, 0.0);
+}
+
+void StimulusSchedule::compile()
+{	stable_sort(events_.begin(), events_.end(), [](Event const& a, Event const& b) { return a.step<b.step; });
+	compiled_=true;
+}
+
+void StimulusSchedule::reset(size_t const& neurons)
+{	if(!compiled_)
+	{	compile();
+	}
+	next_=0;
+	currents_.assign(stimuli_.size(), 0.0);
+	totals_.assign(neurons, 0.0);
+}
+
+void StimulusSchedule::apply(unsigned int const& time, function<void(unsigned int, double)> const& set)
+{	assert(compiled_);
+	
+	/*	The currents of the neurons of a group are only changed by the difference of the current of the stimulus.	*/
+	for(;next_<events_.size() && events_[next_].step<=time;++next_)
+	{	Event const& event(events_[next_]);
+		double change(event.current-currents_[event.stimulus]);
+		currents_[event.stimulus]=event.current;
+		vector<unsigned int> const& neurons(groups_[stimuli_[event.stimulus]]);
+		for(size_t k(0);k<neurons.size();++k)
+		{	assert(neurons[k]<totals_.size());
+			totals_[neurons[k]]+=change;
+			set(neurons[k], totals_[neurons[k]]);
+		}
+	}
+}
+
+void StimulusSchedule::addEvent(unsigned int const& stimulus, unsigned int const& step, double const& current)
+{	
+	/*	The events of a stimulus are added together, so its previous current is the one of the last event. An
+	 * 	event which does not change the current is not kept.	*/
+	double previous(!events_.empty() && events_.back().stimulus==stimulus ? events_.back().current : 0.0);
+	if(current!=previous)
+	{	Event event = {step, stimulus, current};
+		events_.push_back(event);
+		compiled_=false;
+	}
+}
+
+unsigned int StimulusSchedule::addStimulus(unsigned int const& group)
+{	assert(group<groups_.size());
+	stimuli_.push_back(group);
+	return stimuli_.size()-1;
+}
+
+unsigned int StimulusSchedule::toStep(double const& time)
+{	assert(time>=0.0);
+	return static_cast<unsigned int>(round(time/dt));
+}
@@ -0,0 +1,136 @@
+#ifndef STIMULUSSCHEDULE_H
+#define STIMULUSSCHEDULE_H
+
+#include <math.h>
+#include <vector>
+#include <utility>
+#include <functional>
+#include "CounterRandom.hpp"
+#include "Utility/Constants.hpp"
+#include "Utility/View.hpp"
+
+using namespace std;
+
+//! StimulusSchedule class
+/*!	Time-varying currents applied to groups of neurons during a simulation, added to their constant inputs.
+ * 	Each stimulus is piecewise-constant, a ramp, a sinusoid or a gaussian noise shared by its group.
+ *
+ * 	The stimuli are compiled into a timeline of the changes of their currents, sorted by time step: a
+ * 	piecewise-constant stimulus only has an event at each change, and the other ones an event at each step
+ * 	of their window. At each time step, only the neurons of the groups whose current changes are touched.	*/
+class StimulusSchedule
+{
+	private:
+	//! Change of the current of a stimulus
+	struct Event
+	{	unsigned int step;		/**<	Time step from which the current applies.	*/
+		unsigned int stimulus;	/**<	Index of the stimulus.						*/
+		double current;			/**<	New current of the stimulus.				*/
+	};
+
+	vector<vector<unsigned int>> groups_;	/**<	Neurons of each group.									*/
+	vector<unsigned int> stimuli_;			/**<	Group of each stimulus.									*/
+	vector<Event> events_;					/**<	Changes of the currents, sorted by time step once compiled.	*/
+	bool compiled_;							/**<	Whether the events are sorted.							*/
+	size_t next_;							/**<	First event not applied yet.							*/
+	vector<double> currents_;				/**<	Present current of each stimulus.						*/
+	vector<double> totals_;					/**<	Sum of the currents of the stimuli of each neuron.		*/
+
+	public:
+	//! Constructor
+	/*!	Creates an empty schedule.	*/
+	StimulusSchedule();
+
+/***************************************************/
+	/*	Getters	*/
+	//! Gets the number of events of the timeline
+	size_t getEvents() const;
+	//! Gets the sum of the currents of the stimuli applied to a neuron
+	double getCurrent(unsigned int const& neuron) const;
+
+/***************************************************/
+	//!A public function taking a vector of neurons as parameter
+	/*!	@param neurons: Indexes of the neurons of the group.
+	 * 	@return unsigned int: Index of the group.	*/
+	unsigned int addGroup(vector<unsigned int> const& neurons);
+
+	//!A public function taking a range of neurons as parameter
+	/*!	@param first: First neuron of the group.
+	 * 	@param last: Neuron after the last one of the group.
+	 * 	@return unsigned int: Index of the group.	*/
+	unsigned int addGroup(unsigned int const& first, unsigned int const& last);
+
+	//!A public function taking a group and changes of current as parameters
+	/*!	Piecewise-constant current: each current applies from its time until the next change.
+	 * 	@param group: Index of the group.
+	 * 	@param changes: Times in ms, increasing, and currents from these times. The last current lasts
+	 * 	until the end of the simulation, unless it is 0.	*/
+	void addSteps(unsigned int const& group, vector<pair<double, double>> const& changes);
+
+	//!A public function taking a group, a window and two currents as parameters
+	/*!	Current varying linearly during a window, and 0 after it.
+	 * 	@param group: Index of the group.
+	 * 	@param start: Beginning of the window in ms.
+	 * 	@param stop: End of the window in ms.
+	 * 	@param from: Current at the beginning of the window.
+	 * 	@param to: Current reached at the end of the window.	*/
+	void addRamp(unsigned int const& group, double const& start, double const& stop, double const& from, double const& to);
+
+	//!A public function taking a group, a window and the parameters of a sinusoid as parameters
+	/*!	Current offset+amplitude*sin(2*pi*frequency*(t-start)) during a window, and 0 after it.
+	 * 	@param group: Index of the group.
+	 * 	@param start: Beginning of the window in ms.
+	 * 	@param stop: End of the window in ms.
+	 * 	@param offset: Mean current.
+	 * 	@param amplitude: Amplitude of the oscillation of the current.
+	 * 	@param frequency: Frequency in Hz.	*/
+	void addSine(unsigned int const& group, double const& start, double const& stop, double const& offset,
+					double const& amplitude, double const& frequency);
+
+	//!A public function taking a group, a window and the parameters of a noise as parameters
+	/*!	Gaussian current drawn at each step of a window, the same for all the neurons of the group, and 0
+	 * 	after it. The currents only depend on the seed, the stimulus and the time step.
+	 * 	@param group: Index of the group.
+	 * 	@param start: Beginning of the window in ms.
+	 * 	@param stop: End of the window in ms.
+	 * 	@param mean: Mean current.
+	 * 	@param sigma: Standard deviation of the current.
+	 * 	@param seed: Seed of the noise.	*/
+	void addNoise(unsigned int const& group, double const& start, double const& stop, double const& mean,
+					double const& sigma, unsigned int const& seed);
+
+	//!A public function
+	/*!	Sorts the events of the stimuli by time step, the events of a step keeping the order in which
+	 * 	the stimuli have been added. Stimuli added afterwards compile the timeline again.	*/
+	void compile();
+
+	//!A public function taking a number of neurons as parameter
+	/*!	Starts the timeline from the beginning, with no current applied.
+	 * 	@param neurons: Number of neurons of the network.	*/
+	void reset(size_t const& neurons);
+
+	//!A public function taking a time step and a function as parameters
+	/*!	Applies the events of the timeline up to a time step.
+	 * 	@param time: Time step, at least the one of the last call.
+	 * 	@param set: Function receiving each neuron whose current changes, and the sum of its currents.	*/
+	void apply(unsigned int const& time, function<void(unsigned int, double)> const& set);
+
+	private:
+	//!A private function taking a stimulus, a time and a current as parameters
+	/*!	@param stimulus: Index of the stimulus.
+	 * 	@param step: Time step of the change.
+	 * 	@param current: New current of the stimulus.	*/
+	void addEvent(unsigned int const& stimulus, unsigned int const& step, double const& current);
+
+	//!A private function taking a group as parameter
+	/*!	@param group: Index of the group of the stimulus.
+	 * 	@return unsigned int: Index of the new stimulus.	*/
+	unsigned int addStimulus(unsigned int const& group);
+
+	//!A private function taking a time as parameter
+	/*!	@param time: Time in ms.
+	 * 	@return unsigned int: Nearest time step.	*/
+	static unsigned int toStep(double const& time);
+};
+
+#endif
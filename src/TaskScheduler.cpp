@@ -0,0 +1,125 @@
+#include "TaskScheduler.hpp"
+#include <cassert>
+
+TaskScheduler::TaskScheduler(unsigned int threads)
+	:	task_(nullptr), remaining_(0), steals_(0), generation_(0), stop_(false)
+{
+	/*	hardware_concurrency() may not know the number of CPUs.	*/
+	if(threads==0)
+	{	threads=1;
+	}
+	for(unsigned int i(0);i<threads;++i)
+	{	queues_.push_back(new Queue);
+	}
+	for(unsigned int i(1);i<threads;++i)
+	{	threads_.push_back(thread(&TaskScheduler::work, this, i));
+	}
+}
+
+TaskScheduler::~TaskScheduler()
+{	{	lock_guard<mutex> lock(mutex_);
+		stop_=true;
+	}
+	start_.notify_all();
+	for(size_t i(0);i<threads_.size();++i)
+	{	threads_[i].join();
+	}
+	for(size_t i(0);i<queues_.size();++i)
+	{	delete queues_[i];
+	}
+}
+
+/***************************************************/
+/*	Getters	*/
+
+unsigned int TaskScheduler::getThreads() const
+{	return queues_.size();
+}
+
+size_t TaskScheduler::getSteals() const
+{	return steals_;
+}
+
+/***************************************************/
+
+void TaskScheduler::run(size_t const& tasks, function<void(size_t)> const& task)
+{	if(tasks==0)
+	{	return;
+	}
+
+	/*	The task is known before any thread can find one in the queues.	*/
+	task_=&task;
+	remaining_=tasks;
+
+	/*	Each thread is given a contiguous block of tasks.	*/
+	size_t threads(queues_.size());
+	for(size_t w(0);w<threads;++w)
+	{	lock_guard<mutex> lock(queues_[w]->lock);
+		for(size_t t(tasks*w/threads);t<tasks*(w+1)/threads;++t)
+		{	queues_[w]->tasks.push_back(t);
+		}
+	}
+
+	{	lock_guard<mutex> lock(mutex_);
+		++generation_;
+	}
+	start_.notify_all();
+
+	/*	The caller executes tasks too, and waits for the last ones executed by the other threads.	*/
+	while(remaining_>0)
+	{	if(!execute(0))
+		{	this_thread::yield();
+		}
+	}
+	task_=nullptr;
+}
+
+void TaskScheduler::work(unsigned int const& worker)
+{	unsigned int seen(0);
+	while(true)
+	{	{	unique_lock<mutex> lock(mutex_);
+			start_.wait(lock, [&]{ return stop_ || generation_!=seen; });
+			if(stop_)
+			{	return;
+			}
+			seen=generation_;
+		}
+
+		/*	Once no task can be found, the thread waits for the next run.	*/
+		while(execute(worker))
+		{}
+	}
+}
+
+bool TaskScheduler::execute(unsigned int const& worker)
+{	size_t threads(queues_.size());
+	size_t index(0);
+	bool found(false);
+
+	/*	The thread takes the next task of its own queue...	*/
+	{	lock_guard<mutex> lock(queues_[worker]->lock);
+		if(!queues_[worker]->tasks.empty())
+		{	index=queues_[worker]->tasks.front();
+			queues_[worker]->tasks.pop_front();
+			found=true;
+		}
+	}
+
+	/*	...or the last task of another queue.	*/
+	for(size_t i(1);i<threads && !found;++i)
+	{	Queue* victim(queues_[(worker+i)%threads]);
+		lock_guard<mutex> lock(victim->lock);
+		if(!victim->tasks.empty())
+		{	index=victim->tasks.back();
+			victim->tasks.pop_back();
+			found=true;
+			++steals_;
+		}
+	}
+
+	if(found)
+	{	(*task_)(index);
+		--remaining_;
+	}
+	return found;
+}
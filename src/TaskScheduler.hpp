@@ -0,0 +1,81 @@
+#ifndef TASKSCHEDULER_H
+#define TASKSCHEDULER_H
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+
+using namespace std;
+
+//! TaskScheduler class
+/*!	Pool of threads executing tasks with work stealing.
+ *
+ * 	The tasks of a run are numbered and shared in contiguous blocks between the threads. Each thread
+ * 	executes the tasks of its own queue from the front, and once it is empty, steals tasks from the back
+ * 	of the queues of the other threads, so that a thread which has been given expensive tasks (the ones
+ * 	of a burst of spikes, for instance) is helped by the others. The thread calling run() takes part in
+ * 	the execution as the first thread.	*/
+class TaskScheduler
+{
+	private:
+
+	/*!	Queue of tasks of a thread.	*/
+	struct Queue
+	{	mutex lock;				/**<	Protects the tasks.			*/
+		deque<size_t> tasks;	/**<	Indexes of the tasks.		*/
+	};
+
+	vector<Queue*> queues_;						/**<	Queue of each thread, the first one being the one of the caller.	*/
+	vector<thread> threads_;					/**<	Threads of the pool, without the caller.							*/
+	function<void(size_t)> const* task_;		/**<	Task of the present run.											*/
+	atomic<size_t> remaining_;					/**<	Number of tasks of the present run not finished yet.				*/
+	atomic<size_t> steals_;						/**<	Number of tasks executed by another thread than their own.		*/
+
+	mutex mutex_;								/**<	Protects the generation and the stop flag.							*/
+	condition_variable start_;					/**<	Wakes the threads up at the beginning of a run.						*/
+	unsigned int generation_;					/**<	Number of runs started.												*/
+	bool stop_;									/**<	Set when the pool is destroyed.										*/
+
+	//!A private function taking an unsigned int as parameter
+	/*!	Loop of a thread of the pool, executing the tasks of each run.
+	 * 	@param worker: Index of the thread.	*/
+	void work(unsigned int const& worker);
+
+	//!A private function taking an unsigned int as parameter
+	/*!	Executes a task of the queue of a thread, or one stolen from another queue.
+	 * 	@param worker: Index of the thread.
+	 * 	@return bool: Whether a task has been found.	*/
+	bool execute(unsigned int const& worker);
+
+	public:
+	//! Constructor
+	/*!	@param threads: Number of threads executing the tasks, including the caller of run().	*/
+	explicit TaskScheduler(unsigned int threads=thread::hardware_concurrency());
+
+	//! Destructor
+	/*!	Stops the threads of the pool.	*/
+	~TaskScheduler();
+
+	TaskScheduler(TaskScheduler const&) = delete;
+	TaskScheduler& operator=(TaskScheduler const&) = delete;
+
+/***************************************************/
+	/*	Getters	*/
+	//! Gets the number of threads executing the tasks, including the caller
+	unsigned int getThreads() const;
+	//! Gets the number of tasks stolen since the creation of the scheduler
+	size_t getSteals() const;
+
+/***************************************************/
+	//!A public function taking a number of tasks and a function as parameters
+	/*!	Executes tasks in parallel, and returns once all of them are finished.
+	 * 	@param tasks: Number of tasks.
+	 * 	@param task: Function called with the index of each task, from any thread.	*/
+	void run(size_t const& tasks, function<void(size_t)> const& task);
+};
+
+#endif
@@ -0,0 +1,116 @@
+#include "Topology.hpp"
+#include <cassert>
+#include <fstream>
+#include <sstream>
+#include <cstdlib>
+#include <algorithm>
+#include <dirent.h>
+#include <unistd.h>
+
+Topology::Topology()
+{
+	/*	Each directory nodeN contains the list of the CPUs of the node N.	*/
+	DIR* directory(opendir("/sys/devices/system/node"));
+	if(directory!=nullptr)
+	{	vector<pair<unsigned int, vector<unsigned int>>> nodes;
+		for(dirent* entry(readdir(directory));entry!=nullptr;entry=readdir(directory))
+		{	string name(entry->d_name);
+			if(name.compare(0, 4, "node")!=0 || name.size()==4 || name.find_first_not_of("0123456789", 4)!=string::npos)
+			{	continue;
+			}
+			ifstream file("/sys/devices/system/node/"+name+"/cpulist");
+			string list;
+			getline(file, list);
+			vector<unsigned int> cpus(parseList(list));
+
+			/*	Nodes with memory only are left out, since no worker can run on them.	*/
+			if(!cpus.empty())
+			{	nodes.push_back(make_pair(atoi(name.c_str()+4), cpus));
+			}
+		}
+		closedir(directory);
+
+		sort(nodes.begin(), nodes.end());
+		for(size_t i(0);i<nodes.size();++i)
+		{	ids_.push_back(nodes[i].first);
+			cpus_.push_back(nodes[i].second);
+		}
+	}
+
+	/*	Without NUMA information, the machine is a single node.	*/
+	if(cpus_.empty())
+	{	long online(sysconf(_SC_NPROCESSORS_ONLN));
+		vector<unsigned int> cpus;
+		for(long i(0);i<(online>0 ? online : 1);++i)
+		{	cpus.push_back(i);
+		}
+		ids_.push_back(0);
+		cpus_.push_back(cpus);
+	}
+}
+
+Topology::Topology(vector<vector<unsigned int>> const& cpus)
+	:	cpus_(cpus)
+{	assert(!cpus_.empty());
+	for(size_t i(0);i<cpus_.size();++i)
+	{	assert(!cpus_[i].empty());
+		ids_.push_back(i);
+	}
+}
+
+/***************************************************/
+/*	Getters	*/
+
+unsigned int Topology::getNodes() const
+{	return cpus_.size();
+}
+
+unsigned int Topology::getId(unsigned int const& node) const
+{	assert(node<ids_.size());
+	return ids_[node];
+}
+
+vector<unsigned int> const& Topology::getCpus(unsigned int const& node) const
+{	assert(node<cpus_.size());
+	return cpus_[node];
+}
+
+unsigned int Topology::getTotalCpus() const
+{	unsigned int total(0);
+	for(size_t i(0);i<cpus_.size();++i)
+	{	total+=cpus_[i].size();
+	}
+	return total;
+}
+
+/***************************************************/
+
+vector<unsigned int> Topology::parseList(string const& list)
+{	vector<unsigned int> cpus;
+	istringstream stream(list);
+	string range;
+
+	/*	The list is made of ranges "a-b" or single CPUs, separated by commas.	*/
+	while(getline(stream, range, ','))
+	{	if(range.find_first_of("0123456789")==string::npos)
+		{	continue;
+		}
+		size_t dash(range.find('-'));
+		unsigned int first(atoi(range.c_str()));
+		unsigned int last(dash==string::npos ? first : atoi(range.c_str()+dash+1));
+		for(unsigned int cpu(first);cpu<=last;++cpu)
+		{	cpus.push_back(cpu);
+		}
+	}
+	return cpus;
+}
+
+void Topology::print(ostream& out) const
+{	for(size_t i(0);i<cpus_.size();++i)
+	{	out<<"node "<<ids_[i]<<":";
+		for(size_t j(0);j<cpus_[i].size();++j)
+		{	out<<" "<<cpus_[i][j];
+		}
+		out<<endl;
+	}
+}
@@ -0,0 +1,67 @@
+#ifndef TOPOLOGY_H
+#define TOPOLOGY_H
+
+#include <vector>
+#include <string>
+#include <iostream>
+
+using namespace std;
+
+//! Topology class
+/*!	NUMA nodes of the machine and the CPUs they contain, read from /sys/devices/system/node.
+ *
+ * 	On a machine without this information, all the CPUs available are in a single node.	*/
+class Topology
+{
+	private:
+
+	vector<vector<unsigned int>> cpus_;		/**<	CPUs of each node, in increasing order.				*/
+	vector<unsigned int> ids_;				/**<	Identifier of each node in the system.				*/
+
+	public:
+	//! Constructor
+	/*!	Reads the topology of the machine.	*/
+	Topology();
+
+	//! Constructor
+	/*!	@param cpus: CPUs of each node, the nodes being numbered from 0.	*/
+	explicit Topology(vector<vector<unsigned int>> const& cpus);
+
+	/*********************************************************************************************************************
+	 * 											GETTERS																	 *
+	 * *******************************************************************************************************************/
+
+	//!A public getter
+	/*!	@return unsigned int: Number of nodes having CPUs.	*/
+	unsigned int getNodes() const;
+
+	//!A public getter taking an unsigned int as parameter
+	/*!	@param node: Index of a node.
+	 * 	@return unsigned int: Identifier of the node in the system.	*/
+	unsigned int getId(unsigned int const& node) const;
+
+	//!A public getter taking an unsigned int as parameter
+	/*!	@param node: Index of a node.
+	 * 	@return vector<unsigned int> const&: CPUs of the node.	*/
+	vector<unsigned int> const& getCpus(unsigned int const& node) const;
+
+	//!A public getter
+	/*!	@return unsigned int: Total number of CPUs.	*/
+	unsigned int getTotalCpus() const;
+
+	/*********************************************************************************************************************
+	 * 											METHODS																	 *
+	 * *******************************************************************************************************************/
+
+	//!A public function taking a string as parameter
+	/*!	@param list: List of CPUs in the format of the kernel, such as "0-3,8,10-11".
+	 * 	@return vector<unsigned int>: CPUs of the list.	*/
+	static vector<unsigned int> parseList(string const& list);
+
+	//!A public function taking an ostream as parameter
+	/*!	Writes the nodes and their CPUs.
+	 * 	@param out: Stream written.	*/
+	void print(ostream& out) const;
+};
+
+#endif
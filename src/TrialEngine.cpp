@@ -0,0 +1,172 @@
+#include "TrialEngine.hpp"
+#include <cassert>
+
+constexpr size_t TrialEngine::Lanes;
+
+TrialEngine::TrialEngine(Network const& network, vector<unsigned int> const& seeds)
+	:	network_(network), trials_(seeds.size()), neurons_(network.getNeurons().size()),
+		mask_(RingBuffer::depthFor(network.getMaxDelay())-1), clock_time_(network.getClockTime()),
+		random_wanted_(network.hasRandomSpikes()), seeds_(seeds), poisson_(ExternalFrequency*dt), inputs_(neurons_),
+		amplitudes_(neurons_), potentials_(neurons_*trials_), refractory_(neurons_*trials_),
+		buffers_((mask_+1)*neurons_*trials_, 0.0), spiked_(neurons_*trials_, 0.0), trains_(trials_, SpikeTrains(neurons_)),
+		rows_read_(0)
+{	assert(trials_>0 && network.getExternalInput()==PoissonInput && network.getSpikeSource()==nullptr
+			&& network.getStimuli()==nullptr);
+
+	/*	Each trial starts from the state of the neurons of the network.	*/
+	View<Neuron* const> neurons(network_.getNeurons());
+	for(size_t i(0);i<neurons_;++i)
+	{	inputs_[i]=neurons[i]->getInput();
+		amplitudes_[i]=network_.getAmplitude(i);
+		for(size_t t(0);t<trials_;++t)
+		{	potentials_[i*trials_+t]=neurons[i]->getMembranePotential();
+			refractory_[i*trials_+t]=neurons[i]->getRefractoryTime();
+		}
+		for(unsigned int step(clock_time_);step<clock_time_+neurons[i]->getBufferDepth();++step)
+		{	for(size_t t(0);t<trials_;++t)
+			{	buffers_[((step&mask_)*neurons_+i)*trials_+t]=neurons[i]->getBuffer(step);
+			}
+		}
+	}
+}
+
+/***************************************************/
+/*	Getters	*/
+
+size_t TrialEngine::getTrials() const
+{	return trials_;
+}
+
+unsigned int TrialEngine::getClockTime() const
+{	return clock_time_;
+}
+
+double TrialEngine::getMembranePotential(size_t const& trial, unsigned int const& neuron) const
+{	return potentials_[neuron*trials_+trial];
+}
+
+SpikeTrains const& TrialEngine::getTrains(size_t const& trial) const
+{	return trains_[trial];
+}
+
+size_t TrialEngine::getTotalSpikes(size_t const& trial) const
+{	size_t total(0);
+	for(size_t i(0);i<neurons_;++i)
+	{	total+=trains_[trial][i].size();
+	}
+	return total;
+}
+
+size_t TrialEngine::getRowsRead() const
+{	return rows_read_;
+}
+
+/***************************************************/
+
+void TrialEngine::update(double const& endtime)
+{	unsigned int end(endtime/dt);
+	while(clock_time_<end)
+	{	integrate();
+		transmit();
+		++clock_time_;
+	}
+}
+
+void TrialEngine::integrate()
+{	spiking_.clear();
+	offsets_.assign(1, 0);
+	spiking_trials_.clear();
+
+	/*	The trials left after the last complete block are updated one by one.	*/
+	for(size_t i(0);i<neurons_;++i)
+	{	bool any(false);
+		size_t t(0);
+		for(;t+Lanes<=trials_;t+=Lanes)
+		{	any=integrateTrials<Lanes>(i, t) || any;
+		}
+		for(;t<trials_;++t)
+		{	any=integrateTrials<1>(i, t) || any;
+		}
+		if(any)
+		{	spiking_.push_back(i);
+			offsets_.push_back(spiking_trials_.size());
+		}
+	}
+}
+
+template<size_t Width>
+bool TrialEngine::integrateTrials(size_t const& neuron, size_t const& first)
+{	Real const c(C), threshold(MembraneThreshold), reset(MembraneReset), amplitude(Amplitude);
+	Real* potentials(&potentials_[neuron*trials_+first]);
+	unsigned int* refractory(&refractory_[neuron*trials_+first]);
+	Accumulator* read(&buffers_[((clock_time_&mask_)*neurons_+neuron)*trials_+first]);
+	Accumulator* spiked(&spiked_[neuron*trials_+first]);
+	Real input(inputs_[neuron]*Real(D));
+	Accumulator sent(amplitudes_[neuron]);
+
+	unsigned int noise[Width] = {0};
+	if(random_wanted_)
+	{	double uniforms[Width];
+		CounterRandom::uniformLanes<Width>(NoiseStream, neuron, clock_time_, &seeds_[first], uniforms);
+		poisson_.lanes<Width>(uniforms, noise);
+	}
+
+	/*	Same update as Neuron::update, the new state being selected in each trial instead of branching.	*/
+	bool spikes[Width];
+	bool any(false);
+	for(size_t t(0);t<Width;++t)
+	{	bool refractory_now(refractory[t]>0);
+		bool spike(!refractory_now && potentials[t]>threshold);
+		Real next(potentials[t]*c+input+Real(double(read[t]+noise[t]*amplitude)));
+		potentials[t]=(refractory_now ? reset : (spike ? potentials[t] : next));
+		refractory[t]=(refractory_now ? refractory[t]-1 : (spike ? static_cast<unsigned int>(RefractoryPeriod)-1 : 0u));
+		spiked[t]=(spike ? sent : Accumulator(0.0));
+		read[t]=0.0;
+		spikes[t]=spike;
+		any=any || spike;
+	}
+
+	/*	The spikes are recorded in the order of the trials.	*/
+	if(any)
+	{	for(size_t t(0);t<Width;++t)
+		{	if(spikes[t])
+			{	trains_[first+t][neuron].push_back(clock_time_);
+				spiking_trials_.push_back(first+t);
+			}
+		}
+	}
+	return any;
+}
+
+void TrialEngine::transmit()
+{
+	/*	The targets of a delay are read once for all the trials in which the neuron spiked.	*/
+	for(size_t k(0);k<spiking_.size();++k)
+	{	unsigned int neuron(spiking_[k]);
+		Accumulator const* spiked(&spiked_[neuron*trials_]);
+		unsigned int const* trials(spiking_trials_.data()+offsets_[k]);
+		size_t number(offsets_[k+1]-offsets_[k]);
+		Accumulator amplitude(amplitudes_[neuron]);
+		++rows_read_;
+		for(unsigned int delay(network_.getMinDelay());delay<=network_.getMaxDelay();++delay)
+		{	View<unsigned int const> targets(network_.getTargets(neuron, delay));
+			Accumulator* slot(&buffers_[((clock_time_+delay)&mask_)*neurons_*trials_]);
+			if(2*number>=trials_)
+			{	/*	All the slots of a target are written, 0 being added in the trials which did not spike.	*/
+				for(size_t j(0);j<targets.size();++j)
+				{	Accumulator* write(slot+targets[j]*trials_);
+					for(size_t t(0);t<trials_;++t)
+					{	write[t]+=spiked[t];
+					}
+				}
+			} else {
+				for(size_t j(0);j<targets.size();++j)
+				{	Accumulator* write(slot+targets[j]*trials_);
+					for(size_t t(0);t<number;++t)
+					{	write[trials[t]]+=amplitude;
+					}
+				}
+			}
+		}
+	}
+}
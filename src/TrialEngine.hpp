@@ -0,0 +1,101 @@
+#ifndef TRIALENGINE_H
+#define TRIALENGINE_H
+
+#include <vector>
+#include "Network.hpp"
+#include "SpikeComparison.hpp"
+#include "CounterRandom.hpp"
+
+using namespace std;
+
+//! TrialEngine class
+/*!	Simulates several trials of the same network together, each trial receiving the random spikes of its own
+ * 	seed. The links, delays, inputs and amplitudes are the ones of the network, which is only read.
+ *
+ * 	The state is laid out trial after trial for each neuron: the membrane potentials, the refractory times
+ * 	and the buffer slots of the trials of a neuron are contiguous. The trials of a neuron are updated by
+ * 	blocks of Lanes trials, in loops of a constant number of iterations without branches which the compiler
+ * 	vectorizes, the random numbers of the trials of a block being drawn together. When a neuron spikes in some trials, its row of links is read once and the amplitude is
+ * 	added in the buffers of the trials which spiked: in all the slots of the target when most trials
+ * 	spiked, 0 being added in the others, and trial by trial otherwise, since in the asynchronous regime
+ * 	the trials seldom spike together.
+ *
+ * 	A trial simulated with the seed of the network has the spike trains of Network::update, and a trial
+ * 	does not depend on the other trials simulated with it. The engine does not write the files nor
+ * 	update the statistics of the network.	*/
+class TrialEngine
+{
+	private:
+
+	Network const& network_;			/**<	Network simulated, giving the links and the amplitudes.					*/
+	size_t trials_;						/**<	Number of trials.														*/
+	size_t neurons_;					/**<	Number of neurons of the network.										*/
+	unsigned int mask_;					/**<	Depth of the buffers - 1, for the longest delay of the network.			*/
+	unsigned int clock_time_;			/**<	Global time of the trials.												*/
+	bool random_wanted_;				/**<	Whether the neurons receive random spikes.								*/
+
+	vector<uint32_t> seeds_;			/**<	Seed of the generator of the random spikes of each trial.				*/
+	PoissonInverse poisson_;			/**<	Number of random spikes received by a neuron during a time step.		*/
+
+	vector<Real> inputs_;				/**<	External current of each neuron, the same in all trials.				*/
+	vector<double> amplitudes_;			/**<	Amplitude of the spikes of each neuron.									*/
+	vector<Real> potentials_;			/**<	Membrane potentials, trials_ per neuron.								*/
+	vector<unsigned int> refractory_;	/**<	Refractory times left, trials_ per neuron.								*/
+	vector<Accumulator> buffers_;		/**<	Buffers, trials_ per neuron and neurons_ per slot.						*/
+	vector<Accumulator> spiked_;		/**<	Amplitude sent in each trial by each neuron, 0 if it did not spike.		*/
+	vector<unsigned int> spiking_;		/**<	Neurons which spiked in at least one trial during the present step.		*/
+	vector<size_t> offsets_;			/**<	First trial of each neuron of spiking_ in spiking_trials_.				*/
+	vector<unsigned int> spiking_trials_;	/**<	Trials in which each neuron of spiking_ spiked.						*/
+	vector<SpikeTrains> trains_;		/**<	Spike trains of each trial.												*/
+	size_t rows_read_;					/**<	Number of rows of links read to deliver the spikes.						*/
+
+	public:
+	static constexpr size_t Lanes=8;	/**<	Number of trials of a neuron updated together.	*/
+
+	//! Constructor
+	/*!	The trials start from the present state of the network.
+	 * 	@param network: Network simulated, which must outlive the engine, with Poisson random spikes if any and no spike source
+	 * 	nor stimuli.
+	 * 	@param seeds: Seed of the random spikes of each trial.	*/
+	TrialEngine(Network const& network, vector<unsigned int> const& seeds);
+
+/***************************************************/
+	/*	Getters	*/
+	//! Gets the number of trials
+	size_t getTrials() const;
+	//! Gets the clock time of the trials
+	unsigned int getClockTime() const;
+	//! Gets the membrane potential of a neuron in a trial
+	double getMembranePotential(size_t const& trial, unsigned int const& neuron) const;
+	//! Gets the spike trains of a trial
+	SpikeTrains const& getTrains(size_t const& trial) const;
+	//! Gets the number of spikes of a trial
+	size_t getTotalSpikes(size_t const& trial) const;
+	//! Gets the number of rows of links read, once per neuron and time step whatever the number of trials
+	size_t getRowsRead() const;
+
+/***************************************************/
+	//!A public function taking a double as parameter
+	/*!	Simulates the trials until a time.
+	 * 	@param endtime: Time at which the simulation will end.	*/
+	void update(double const& endtime);
+
+	private:
+	//!A private function
+	/*!	Updates the neurons of all trials for the present time step.	*/
+	void integrate();
+
+	//!A private template function taking a neuron and a trial as parameters
+	/*!	Updates a neuron in Width trials for the present time step.
+	 * 	@param neuron: Index of the neuron.
+	 * 	@param first: First trial updated.
+	 * 	@return bool: Whether the neuron spiked in at least one of the trials.	*/
+	template<size_t Width>
+	bool integrateTrials(size_t const& neuron, size_t const& first);
+
+	//!A private function
+	/*!	Delivers the spikes of the present time step in the buffers of the trials which spiked.	*/
+	void transmit();
+};
+
+#endif
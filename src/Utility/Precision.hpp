@@ -0,0 +1,23 @@
+#ifndef PRECISION_H
+#define PRECISION_H
+
+//!	Precision of the state of the neurons, chosen when compiling
+/*!	By default, the membrane potentials, inputs and buffers are in double precision. With SINGLE_PRECISION
+ * 	defined, they are all in single precision, which halves the memory read at each time step. With
+ * 	MIXED_PRECISION defined, the membrane potentials and inputs are in single precision while the sums of
+ * 	the spikes received in the buffers stay in double precision.	*/
+#if defined(SINGLE_PRECISION)
+typedef float Real;									/**<	Type of the membrane potentials and inputs.			*/
+typedef float Accumulator;							/**<	Type of the sums of spikes in the buffers.			*/
+const char* const PrecisionName = "single";			/**<	Name of the precision, for the reports.				*/
+#elif defined(MIXED_PRECISION)
+typedef float Real;
+typedef double Accumulator;
+const char* const PrecisionName = "mixed";
+#else
+typedef double Real;
+typedef double Accumulator;
+const char* const PrecisionName = "double";
+#endif
+
+#endif
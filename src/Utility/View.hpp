@@ -0,0 +1,73 @@
+#ifndef VIEW_H
+#define VIEW_H
+
+#include <cstddef>
+#include <cassert>
+
+//! View class
+/*!	Read-only range on contiguous elements owned by another object, in the spirit of a span: nothing is 
+ * 	copied, and the view must not be used after the elements have been moved or destroyed.	*/
+template<typename T>
+class View
+{
+	private:
+	
+	T* data_;		/**<	First element of the range.		*/
+	size_t size_;	/**<	Number of elements.				*/
+	
+	public:
+	
+	typedef T value_type;
+	typedef T* iterator;
+	typedef T* const_iterator;
+	
+	//! Constructor
+	/*!	@param data: First element of the range.
+	 * 	@param size: Number of elements.	*/
+	View(T* data=nullptr, size_t size=0) : data_(data), size_(size) {}
+	
+	//! Gets the number of elements
+	size_t size() const { return size_; }
+	//! Gets whether the range is empty
+	bool empty() const { return size_==0; }
+	//! Gets the first element of the range
+	T* data() const { return data_; }
+	//! Gets an iterator on the first element
+	T* begin() const { return data_; }
+	//! Gets an iterator past the last element
+	T* end() const { return data_+size_; }
+	//! Gets an element
+	/*!	@param idx: Index of the element.
+	 * 	@return Reference on the element.	*/
+	T& operator[](size_t const& idx) const { assert(idx<size_); return data_[idx]; }
+};
+
+//! MatrixView class
+/*!	Read-only view on a matrix stored row after row in contiguous memory.	*/
+template<typename T>
+class MatrixView
+{
+	private:
+	
+	T* data_;		/**<	First element of the matrix.	*/
+	size_t rows_;	/**<	Number of rows.					*/
+	size_t columns_;/**<	Number of columns.				*/
+	
+	public:
+	//! Constructor
+	/*!	@param data: First element of the matrix.
+	 * 	@param rows: Number of rows.
+	 * 	@param columns: Number of columns.	*/
+	MatrixView(T* data=nullptr, size_t rows=0, size_t columns=0) : data_(data), rows_(rows), columns_(columns) {}
+	
+	//! Gets the number of rows
+	size_t size() const { return rows_; }
+	//! Gets the number of columns
+	size_t getColumns() const { return columns_; }
+	//! Gets a row
+	/*!	@param row: Index of the row.
+	 * 	@return View on the row.	*/
+	View<T> operator[](size_t const& row) const { assert(row<rows_); return View<T>(data_+row*columns_, columns_); }
+};
+
+#endif
@@ -24,7 +24,7 @@ int main()
 	Neuron neuron2;
 	Network network(false, false);
 	
-	network.setNeurons(vector<Neuron*>{ new Neuron(neuron1), new Neuron(neuron2)});
+	network.setNeurons(vector<Neuron>{neuron1, neuron2});
 	network.createLink(vector<unsigned int>{0,1});
 
 	network.update(time); /*	Update of the overall network.	*/
@@ -0,0 +1,19 @@
+#include "SpikeComparison.hpp"
+#include <iostream>
+#include <cstdlib>
+
+using namespace std;
+
+int main(int argc, char** argv)
+{	
+	/*	Usage: CompareSpikes reference test [window]. Both files are written by SpikeTrains, the reference
+	 * 	usually in double precision.	*/
+	if(argc<3)
+	{	cerr<<"Usage: "<<argv[0]<<" reference test [window]"<<endl;
+		return 1;
+	}
+	SpikeComparison comparison(argc>3 ? atoi(argv[3]) : 0);
+	comparison.compare(SpikeComparison::read(argv[1]), SpikeComparison::read(argv[2]));
+	comparison.report(cout);
+	return 0;
+}
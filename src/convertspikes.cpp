@@ -0,0 +1,22 @@
+#include "SpikeReplay.hpp"
+#include <iostream>
+#include <fstream>
+
+using namespace std;
+
+int main(int argc, char** argv)
+{	
+	/*	Usage: ConvertSpikes text binary. The text file has "step neuron" lines sorted by step, like the
+	 * 	jupyterplot.txt file of a network of all 12500 neurons, and the binary file is replayed by SpikeReplay.	*/
+	if(argc<3)
+	{	cerr<<"Usage: "<<argv[0]<<" text binary"<<endl;
+		return 1;
+	}
+	ifstream text(argv[1]);
+	if(text.fail())
+	{	cerr<<"Cannot open "<<argv[1]<<endl;
+		return 1;
+	}
+	cout<<SpikeReplay::convert(text, argv[2])<<" spikes converted"<<endl;
+	return 0;
+}
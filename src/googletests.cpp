@@ -1,6 +1,27 @@
 #include <iostream>
+#include <sstream>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <limits>
+#include <numeric>
+#include <cstdio>
+#include <cstdlib>
+#include <csignal>
+#include <stdexcept>
+#include <system_error>
+#include <unistd.h>
 #include "Neuron.hpp"
 #include "Network.hpp"
+#include "ProcessEngine.hpp"
+#include "SpikeComparison.hpp"
+#include "BrunelEngine.hpp"
+#include "TrialEngine.hpp"
+#include "MeanField.hpp"
+#include "ExternalPopulation.hpp"
+#include "SpikeReplay.hpp"
+#include "StimulusSchedule.hpp"
+#include "MmapSink.hpp"
 #include "gtest/gtest.h"
 
 TEST (NeuronTest, MembranePotential) {
@@ -11,16 +32,16 @@ TEST (NeuronTest, MembranePotential) {
 	
 	
 	neuron.update(0, 0);
-	EXPECT_EQ(20.0*(1.0-std::exp(-0.1/20.0)), neuron.getMembranePotential());
+	EXPECT_EQ(Real(20.0*(1.0-std::exp(-0.1/20.0))), neuron.getMembranePotential());
 }
 TEST(NeuronTest, NumberSpikesWithoutInput) {
 	/*	We check if there are spikes without input (there shouldn't be).	*/
 	/*	Creation of a network without the 12500 neurons initialization and without random spikes.	*/
 	Neuron neuron1, neuron2;
-	Network network(false, false);
+	Network network(false, false, make_shared<NullSink>());
 	
 	/*	Addition of the two neurons wanting to be tested.	 */
-	network.setNeurons(vector<Neuron*>{new Neuron(neuron1), new Neuron(neuron2)});
+	network.setNeurons(vector<Neuron>{neuron1, neuron2});
 	network.createLink(vector<unsigned int>{0,1});
 	
 	/*	Update of the network of 100 milliseconds.	*/
@@ -37,8 +58,8 @@ TEST(NeuronTest, NumberSpikesWithInput1 /*	1	*/) {
 	neuron1.setInput(1.0);
 	
 	/*	Network  without 12500 neurons nor background noise.	*/
-	Network network(false, false);
-	network.setNeurons(vector<Neuron*> {new Neuron(neuron1)});
+	Network network(false, false, make_shared<NullSink>());
+	network.setNeurons(vector<Neuron>{neuron1});
 	
 	network.update(1000);
 	
@@ -50,8 +71,8 @@ TEST(NeuronTest, NumberSpikesWithInput2 /*	1.01	*/ ) {
 	/*	We check if the spikes arrive at the correct time and if there 
 	 * 	are the correct number of them.	*/
 	Neuron neuron1, neuron2;
-	Network network(false, false);
-	network.setNeurons(vector<Neuron*>{new Neuron(neuron1), new Neuron(neuron2)});
+	Network network(false, false, make_shared<NullSink>());
+	network.setNeurons(vector<Neuron>{neuron1, neuron2});
 	network.getNeurons()[0]->setInput(1.01);
 	network.createLink(vector<unsigned int>{0,1});
 	network.update(400);
@@ -64,13 +85,459 @@ TEST(NeuronTest, NumberSpikesWithInput2 /*	1.01	*/ ) {
 	EXPECT_EQ(281.2, network.getNeurons()[0]->getTime()[2]);
 	EXPECT_EQ(375.6, network.getNeurons()[0]->getTime()[3]);
 }
+TEST(NeuronTest, BoundedHistory)
+{	/*	With a capacity of 2, only the last two spikes of the 4 are kept.	*/
+	Neuron neuron1;
+	Network network(false, false, make_shared<NullSink>());
+	network.setNeurons(vector<Neuron>{neuron1});
+	network.getNeurons()[0]->setInput(1.01);
+	network.setHistoryCapacity(2);
+	network.update(400);
+	
+	EXPECT_EQ(2u, network.getNeurons()[0]->getTime().size());
+	EXPECT_EQ(4u, network.getNeurons()[0]->getTime().getTotal());
+	EXPECT_EQ(281.2, network.getNeurons()[0]->getTime()[0]);
+	EXPECT_EQ(3756u, network.getNeurons()[0]->getTime().getStep(1));
+}
+
+TEST(NeuronTest, HistoryChunks)
+{	/*	Spikes spanning several chunks are kept in order, and copies are independent.	*/
+	SpikeHistory history;
+	for(unsigned int step(0);step<3*SpikeHistory::ChunkSize+10;++step)
+	{	history.add(2*step);
+	}
+	SpikeHistory copy(history);
+	history.clear();
+	
+	EXPECT_TRUE(history.empty());
+	ASSERT_EQ(3*SpikeHistory::ChunkSize+10, copy.size());
+	EXPECT_EQ(2*SpikeHistory::ChunkSize, copy.getStep(SpikeHistory::ChunkSize));
+	EXPECT_EQ(2*(3*SpikeHistory::ChunkSize+9), copy.getStep(copy.size()-1));
+	
+	copy.setCapacity(5);
+	EXPECT_EQ(5u, copy.size());
+	EXPECT_EQ(2*(3*SpikeHistory::ChunkSize+5), copy.getStep(0));
+}
+
+TEST(NeuronTest, HistoryThreads)
+{	/*	Histories filled by several threads at once are destroyed by another one.	*/
+	vector<SpikeHistory> histories(4);
+	vector<thread> threads;
+	for(unsigned int t(0);t<histories.size();++t)
+	{	threads.push_back(thread([&histories, t]()
+		{	for(unsigned int step(0);step<10*SpikeHistory::ChunkSize;++step)
+			{	histories[t].add(step+t);
+			}
+		}));
+	}
+	for(size_t t(0);t<threads.size();++t)
+	{	threads[t].join();
+	}
+	for(unsigned int t(0);t<histories.size();++t)
+	{	ASSERT_EQ(10*SpikeHistory::ChunkSize, histories[t].size());
+		EXPECT_EQ(10*SpikeHistory::ChunkSize-1+t, histories[t].getStep(histories[t].size()-1));
+	}
+	histories.clear();
+}
+
+TEST(NeuronTest, AdvanceTo)
+{	/*	A neuron catching up on skipped steps relaxes like a neuron updated at every step, whether it
+	 * 	has been parked once or several times.	*/
+	Neuron stepped, parked, twice;
+	stepped.setMembranePotential(15.0);
+	parked.setMembranePotential(15.0);
+	twice.setMembranePotential(15.0);
+	stepped.setInput(0.6);
+	parked.setInput(0.6);
+	twice.setInput(0.6);
+	for(unsigned int step(0);step<5000;++step)
+	{	stepped.setMembranePotential(stepped.MembranePotentialEquation(0.0));
+	}
+	parked.advanceTo(5000);
+	twice.advanceTo(1700);
+	twice.advanceTo(5000);
+	EXPECT_EQ(5000u, parked.getPresentTime());
+	EXPECT_EQ(stepped.getMembranePotential(), parked.getMembranePotential());
+	EXPECT_EQ(stepped.getMembranePotential(), twice.getMembranePotential());
+	EXPECT_NEAR(12.0, parked.getMembranePotential(), 12.0*sqrt(numeric_limits<Real>::epsilon()));
+}
+
+TEST(NeuronTest, RingBuffer)
+{	/*	The depth is the smallest power of 2 above the delay, and time steps wrap around it.	*/
+	EXPECT_EQ(16u, RingBuffer::depthFor(15));
+	EXPECT_EQ(32u, RingBuffer::depthFor(16));
+	
+	Neuron neuron;
+	EXPECT_EQ(16u, neuron.getBufferDepth());
+	neuron.receive(1000+15, 0.5);
+	EXPECT_EQ(Accumulator(0.5), neuron.getBuffer(1015%16));
+	EXPECT_EQ(Accumulator(0.5), neuron.getBuffer(1015+16));
+	
+	neuron.setMaxDelay(40);
+	EXPECT_EQ(64u, neuron.getBufferDepth());
+	EXPECT_EQ(0.0, neuron.getBuffer(1015));
+}
+
+TEST(RandomTest, CounterBased)
+{	/*	Known answers of Philox4x32-10.	*/
+	CounterRandom::Block zero(CounterRandom::philox({{0, 0, 0, 0}}, {{0, 0}}));
+	EXPECT_EQ(0x6627e8d5u, zero[0]);
+	EXPECT_EQ(0x9b00dbd8u, zero[3]);
+	CounterRandom::Block pi(CounterRandom::philox({{0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}}, {{0xa4093822, 0x299f31d0}}));
+	EXPECT_EQ(0xd16cfe09u, pi[0]);
+	EXPECT_EQ(0x24126ea1u, pi[3]);
+	
+	/*	A draw only depends on the seed, the purpose and the counters.	*/
+	CounterRandom random(3), other(4);
+	EXPECT_EQ(random.uniform(NoiseStream, 12, 1000), CounterRandom(3).uniform(NoiseStream, 12, 1000));
+	EXPECT_NE(random.uniform(NoiseStream, 12, 1000), random.uniform(NoiseStream, 12, 1001));
+	EXPECT_NE(random.uniform(NoiseStream, 12, 1000), random.uniform(DelayStream, 12, 1000));
+	EXPECT_NE(random.uniform(NoiseStream, 12, 1000), other.uniform(NoiseStream, 12, 1000));
+	
+	/*	The Poisson numbers have the mean of the random spikes.	*/
+	PoissonInverse poisson(ExternalFrequency*dt);
+	double sum(0.0);
+	for(unsigned int step(0);step<100000;++step)
+	{	unsigned int number(random.uniform(ConnectivityStream, 7, step, 10, 20));
+		EXPECT_TRUE(number>=10 && number<20);
+		sum+=poisson(random.uniform(NoiseStream, 7, step));
+	}
+	EXPECT_NEAR(ExternalFrequency*dt, sum/100000, 0.02);
+	
+	/*	The gaussian numbers have a mean of 0 and a standard deviation of 1.	*/
+	double squares(0.0);
+	sum=0.0;
+	for(unsigned int step(0);step<100000;++step)
+	{	double z(random.gaussian(NoiseStream, 7, step));
+		sum+=z;
+		squares+=z*z;
+	}
+	EXPECT_NEAR(0.0, sum/100000, 0.01);
+	EXPECT_NEAR(1.0, squares/100000, 0.02);
+}
+
+TEST(RandomTest, Lanes)
+{	/*	The numbers drawn for several generators at once are the ones of each generator.	*/
+	uint32_t seeds[8] = {3, 4, 5, 6, 7, 8, 9, 0xffffffffu};
+	PoissonInverse poisson(ExternalFrequency*dt);
+	for(unsigned int step(0);step<1000;++step)
+	{	double uniforms[8];
+		unsigned int numbers[8];
+		CounterRandom::uniformLanes<8>(NoiseStream, 12, step, seeds, uniforms);
+		poisson.lanes<8>(uniforms, numbers);
+		for(size_t l(0);l<8;++l)
+		{	ASSERT_EQ(CounterRandom(seeds[l]).uniform(NoiseStream, 12, step), uniforms[l]);
+			ASSERT_EQ(poisson(uniforms[l]), numbers[l]);
+		}
+	}
+}
+
+TEST(NetworkTest, DiffusionInput)
+{	/*	The gaussian inputs have the mean and the variance of the random spikes.	*/
+	Network network(false, true, make_shared<NullSink>());
+	network.setNeurons(vector<Neuron>(2));
+	network.setSeed(5);
+	double mean(ExternalFrequency*dt*Amplitude), variance(ExternalFrequency*dt*Amplitude*Amplitude);
+	for(unsigned int input(PoissonInput);input<=OrnsteinUhlenbeckInput;++input)
+	{	network.setExternalInput(ExternalInput(input), 0.5);
+		double sum(0.0), squares(0.0), products(0.0), previous(0.0);
+		unsigned int steps(50000);
+		for(unsigned int step(0);step<steps;++step)
+		{	network.setClockTime(step);
+			double external(network.externalInput(0)-mean);
+			sum+=external;
+			squares+=external*external;
+			products+=external*previous;
+			previous=external;
+		}
+		EXPECT_NEAR(0.0, sum/steps, 0.01);
+		EXPECT_NEAR(variance, squares/steps, 0.03*variance);
+		
+		/*	Only the Ornstein-Uhlenbeck noise is correlated from one time step to the next.	*/
+		double correlation(input==OrnsteinUhlenbeckInput ? exp(-dt/0.5) : 0.0);
+		EXPECT_NEAR(correlation, products/squares, 0.02);
+	}
+	
+	/*	After several time steps without draw, the noise has lost the corresponding correlation.	*/
+	network.setClockTime(100000);
+	double sum(0.0);
+	for(unsigned int k(0);k<20000;++k)
+	{	network.setClockTime(100000+10*k);
+		double first(network.externalInput(1)-mean);
+		network.setClockTime(100000+10*k+5);
+		sum+=first*(network.externalInput(1)-mean);
+	}
+	EXPECT_NEAR(exp(-5*dt/0.5), sum/20000/variance, 0.03);
+}
+
+TEST(NetworkTest, ExternalPopulation)
+{	/*	Each neuron receives the given number of connections, and the generators fire at the frequency
+	 * 	giving the mean input of the random spikes.	*/
+	ExternalPopulation population(100, 500, 7);
+	size_t links(0);
+	for(unsigned int k(0);k<population.getGenerators();++k)
+	{	View<unsigned int const> targets(population.getProjection().getTargets(k));
+		EXPECT_TRUE(is_sorted(targets.begin(), targets.end()));
+		links+=targets.size();
+	}
+	EXPECT_EQ(100u*NumberExternalConnections, links);
+	EXPECT_DOUBLE_EQ(ExternalFrequency*dt, population.getProbability()*NumberExternalConnections);
+	size_t spikes(0);
+	for(unsigned int step(0);step<20000;++step)
+	{	spikes+=population.fire(step).size();
+	}
+	EXPECT_EQ(spikes, population.getTotalSpikes());
+	EXPECT_NEAR(500*population.getProbability()*20000, double(spikes), 600.0);
+	
+	/*	Neurons sharing a small population receive correlated inputs and spike together more often than
+	 * 	neurons driven by a large one.	*/
+	vector<double> variances;
+	for(unsigned int generators : {20u, 100000u})
+	{	Network network(false, false, make_shared<NullSink>());
+		network.setNeurons(vector<Neuron>(100));
+		ExternalPopulation drive(100, generators, 7);
+		network.setSpikeSource(&drive);
+		network.update(200);
+		vector<double> counts(2000, 0.0);
+		SpikeTrains trains(SpikeComparison::collect(network));
+		for(size_t i(0);i<trains.size();++i)
+		{	for(size_t k(0);k<trains[i].size();++k)
+			{	++counts[trains[i][k]];
+			}
+		}
+		double sum(0.0), squares(0.0);
+		for(size_t step(0);step<counts.size();++step)
+		{	sum+=counts[step];
+			squares+=counts[step]*counts[step];
+		}
+		EXPECT_GT(sum, 0.0);
+		variances.push_back(squares/counts.size()-sum*sum/counts.size()/counts.size());
+	}
+	EXPECT_GT(variances[0], 5*variances[1]);
+	
+	/*	The population replaces the random spikes of a network which wants them.	*/
+	Network quiet(false, false, make_shared<NullSink>()), noisy(false, true, make_shared<NullSink>());
+	quiet.setNeurons(vector<Neuron>(100));
+	noisy.setNeurons(vector<Neuron>(100));
+	ExternalPopulation quiet_drive(100, 500, 7), noisy_drive(100, 500, 7);
+	quiet.setSpikeSource(&quiet_drive);
+	noisy.setSpikeSource(&noisy_drive);
+	EXPECT_FALSE(noisy.hasRandomSpikes());
+	quiet.update(100);
+	noisy.update(100);
+	EXPECT_EQ(SpikeComparison::collect(quiet), SpikeComparison::collect(noisy));
+	noisy.setSpikeSource(nullptr);
+	EXPECT_TRUE(noisy.hasRandomSpikes());
+}
+
+/*	Tests which write a binary file do it in a fresh temporary file, removed at the end of the test.	*/
+class FileTest : public ::testing::Test
+{	protected:
+	void SetUp() override
+	{	char name[]="/tmp/spikesXXXXXX";
+		int descriptor(mkstemp(name));
+		ASSERT_NE(-1, descriptor);
+		close(descriptor);
+		path_=name;
+	}
+	void TearDown() override
+	{	if(!path_.empty())
+		{	remove(path_.c_str());
+		}
+	}
+	
+	string path_;
+};
+
+TEST_F(FileTest, SpikeReplay)
+{	/*	The spikes of a network are converted to a binary file, and read back step by step.	*/
+	Network recorded(false, false, make_shared<NullSink>());
+	recorded.setNeurons(vector<Neuron>(6));
+	for(size_t i(0);i<6;++i)
+	{	recorded.getNeurons()[i]->setInput(1.01+0.1*i);
+	}
+	recorded.update(100);
+	SpikeTrains trains(SpikeComparison::collect(recorded));
+	stringstream text;
+	vector<pair<unsigned int, unsigned int>> spikes;
+	for(size_t i(0);i<trains.size();++i)
+	{	for(size_t k(0);k<trains[i].size();++k)
+		{	spikes.push_back(make_pair(trains[i][k], i));
+		}
+	}
+	sort(spikes.begin(), spikes.end());
+	for(size_t k(0);k<spikes.size();++k)
+	{	text<<spikes[k].first<<" "<<spikes[k].second<<endl;
+	}
+	EXPECT_EQ(spikes.size(), SpikeReplay::convert(text, path_));
+	
+	SpikeReplay replay(path_);
+	EXPECT_EQ(6u, replay.getSources());
+	EXPECT_EQ(spikes.size(), replay.getEvents());
+	EXPECT_EQ(spikes.back().first+1, replay.getSteps());
+	size_t read(0);
+	for(unsigned int step(0);step<1000;++step)
+	{	View<unsigned int const> neurons(replay.fire(step));
+		for(size_t k(0);k<neurons.size();++k)
+		{	EXPECT_EQ(spikes[read].first, step);
+			EXPECT_EQ(spikes[read++].second, neurons[k]);
+		}
+	}
+	EXPECT_EQ(spikes.size(), read);
+	
+	/*	Replayed to neurons without input, with the amplitude of a threshold crossing, each spike of a recorded
+	 * 	neuron makes the neuron of the same index spike at the same step.	*/
+	SpikeReplay drive(path_, 2*MembraneThreshold);
+	Network network(false, false, make_shared<NullSink>());
+	network.setNeurons(vector<Neuron>(6));
+	network.setSpikeSource(&drive);
+	network.update(100);
+	SpikeTrains replayed(SpikeComparison::collect(network));
+	for(size_t i(0);i<6;++i)
+	{	ASSERT_EQ(trains[i].size(), replayed[i].size());
+		for(size_t k(0);k<trains[i].size();++k)
+		{	EXPECT_EQ(trains[i][k]+1, replayed[i][k]);
+		}
+	}
+}
+
+TEST_F(FileTest, OutputSinks)
+{	/*	The spikes written in memory are the spike trains of the neurons, and the ones written in a mapped
+	 * 	file are read back by SpikeReplay.	*/
+	shared_ptr<MemorySink> memory(make_shared<MemorySink>());
+	Network network(false, false, memory);
+	network.setNeurons(vector<Neuron>(6));
+	for(size_t i(0);i<6;++i)
+	{	network.getNeurons()[i]->setInput(1.01+0.1*i);
+	}
+	network.update(100);
+	SpikeTrains trains(SpikeComparison::collect(network)), written(6);
+	for(size_t k(0);k<memory->getSpikes().size();++k)
+	{	written[memory->getSpikes()[k].neuron].push_back(memory->getSpikes()[k].step);
+	}
+	EXPECT_EQ(trains, written);
+	EXPECT_EQ(1000u, memory->getSteps().size());
+	EXPECT_EQ(memory->getSpikes().size(), accumulate(memory->getCounts().begin(), memory->getCounts().end(), 0u));
+	
+	size_t events(memory->getSpikes().size());
+	{	shared_ptr<MmapSink> mapped(make_shared<MmapSink>(path_, events-1));
+		Network copy(false, false, mapped);
+		copy.setNeurons(vector<Neuron>(6));
+		for(size_t i(0);i<6;++i)
+		{	copy.getNeurons()[i]->setInput(1.01+0.1*i);
+		}
+		copy.update(100);
+		EXPECT_EQ(events-1, mapped->getEvents());
+		EXPECT_EQ(1u, mapped->getLost());
+		EXPECT_TRUE(mapped->close());
+	}
+	SpikeReplay replay(path_);
+	EXPECT_EQ(events-1, replay.getEvents());
+	size_t read(0);
+	for(unsigned int step(0);step<replay.getSteps();++step)
+	{	View<unsigned int const> neurons(replay.fire(step));
+		for(size_t k(0);k<neurons.size();++k)
+		{	EXPECT_EQ(memory->getSpikes()[read].step, step);
+			EXPECT_EQ(memory->getSpikes()[read++].neuron, neurons[k]);
+		}
+	}
+	EXPECT_EQ(events-1, read);
+	
+	/*	A sink whose file cannot be created throws instead of aborting.	*/
+	EXPECT_THROW(MmapSink(path_+"/sink.bin", 10), system_error);
+	EXPECT_THROW(FileSink(false, path_+"/spikes.txt", path_+"/jupyterplot.txt"), system_error);
+}
+
+TEST(StimulusTest, Timeline)
+{	/*	A piecewise-constant stimulus only has an event at each change of its current.	*/
+	StimulusSchedule schedule;
+	unsigned int all(schedule.addGroup(0, 4)), odd(schedule.addGroup({1, 3}));
+	schedule.addSteps(all, {{1.0, 0.5}, {2.0, 0.5}, {3.0, 0.0}});
+	EXPECT_EQ(2u, schedule.getEvents());
+	schedule.addRamp(odd, 2.0, 3.0, 0.0, 1.0);
+	schedule.addSine(odd, 5.0, 10.0, 0.0, 1.0, 100.0);
+	schedule.addNoise(all, 20.0, 30.0, 0.2, 0.1, 3);
+	schedule.reset(4);
+	
+	/*	The currents of the stimuli of a neuron are added, and only the neurons whose current changes are given.	*/
+	vector<double> currents(4, 0.0);
+	vector<unsigned int> changes(4, 0);
+	auto set = [&](unsigned int neuron, double current) { currents[neuron]=current; ++changes[neuron]; };
+	schedule.apply(9, set);
+	EXPECT_EQ(0.0, currents[0]);
+	schedule.apply(10, set);
+	EXPECT_EQ(0.5, currents[0]);
+	EXPECT_EQ(1u, changes[0]);
+	schedule.apply(25, set);
+	EXPECT_NEAR(0.5+0.5, currents[1], 1e-12);
+	EXPECT_EQ(1u, changes[0]);
+	schedule.apply(29, set);
+	EXPECT_NEAR(0.5+0.9, currents[3], 1e-12);
+	schedule.apply(30, set);
+	EXPECT_NEAR(0.0, currents[3], 1e-12);
+	EXPECT_EQ(2u, changes[0]);
+	
+	/*	A sine of 100 Hz has a period of 100 steps: it is maximal a quarter of a period after it starts.	*/
+	schedule.apply(75, set);
+	EXPECT_NEAR(1.0, currents[1], 1e-12);
+	EXPECT_EQ(0.0, currents[2]);
+	schedule.apply(150, set);
+	EXPECT_NEAR(0.0, currents[1], 1e-12);
+	
+	/*	The noise has the mean and the standard deviation wanted.	*/
+	double sum(0.0), squares(0.0);
+	for(unsigned int step(200);step<300;++step)
+	{	schedule.apply(step, set);
+		sum+=currents[0];
+		squares+=currents[0]*currents[0];
+	}
+	EXPECT_NEAR(0.2, sum/100, 0.03);
+	EXPECT_NEAR(0.1, sqrt(squares/100-sum*sum/10000), 0.03);
+	schedule.apply(300, set);
+	EXPECT_NEAR(0.0, currents[2], 1e-12);
+}
+
+TEST(NetworkTest, Stimuli)
+{	/*	A step current applied by a schedule gives the spikes of the same current set between two updates,
+	 * 	the neurons at rest being parked until their input changes.	*/
+	Network chunks(false, false, make_shared<NullSink>()), scheduled(false, false, make_shared<NullSink>());
+	chunks.setNeurons(vector<Neuron>(3));
+	scheduled.setNeurons(vector<Neuron>(3));
+	chunks.getNeurons()[2]->setInput(0.5);
+	scheduled.getNeurons()[2]->setInput(0.5);
+	StimulusSchedule schedule;
+	schedule.addSteps(schedule.addGroup(1, 3), {{20.0, 1.01}, {60.0, 0.0}});
+	scheduled.setStimuli(&schedule);
+	
+	chunks.update(20);
+	chunks.getNeurons()[1]->setInput(1.01);
+	chunks.getNeurons()[2]->setInput(1.51);
+	chunks.update(60);
+	chunks.getNeurons()[1]->setInput(0.0);
+	chunks.getNeurons()[2]->setInput(0.5);
+	chunks.update(100);
+	scheduled.update(100);
+	
+	SpikeComparison comparison;
+	comparison.compare(SpikeComparison::collect(chunks), SpikeComparison::collect(scheduled));
+	EXPECT_GT(comparison.getReferenceSpikes(), 0u);
+	EXPECT_EQ(3u, comparison.getIdenticalNeurons());
+	for(size_t i(0);i<3;++i)
+	{	EXPECT_EQ(chunks.getNeurons()[i]->getMembranePotential(), scheduled.getNeurons()[i]->getMembranePotential());
+	}
+	
+	/*	Removing the stimuli puts the inputs back.	*/
+	scheduled.setStimuli(nullptr);
+	EXPECT_EQ(0.5, scheduled.getNeurons()[2]->getInput());
+}
+
 TEST(NetworkTest, WithoutSpikes)
 {	/*	We check that the spike does not get transmitted if the first neuron
 		doesn't spike.	*/
 	Neuron neuron1, neuron2;
 	neuron1.setInput(1.01);
-	Network network(false, false);
-	network.setNeurons(vector<Neuron*>{new Neuron(neuron1), new Neuron(neuron2)});
+	Network network(false, false, make_shared<NullSink>());
+	network.setNeurons(vector<Neuron>{neuron1, neuron2});
 	network.createLink(vector<unsigned int>{0,1});
 	
 	/*	We update at Delay after the first spike time of neuron1. */
@@ -81,14 +548,14 @@ TEST(NetworkTest, WithoutSpikes)
 	
 	/*	The second neuron's potential should  0.1, the amplitude, meaning it has 
 	 * 	received the signal from neuron 1.	*/
-	EXPECT_EQ(0.1, network.getNeurons()[1]->getMembranePotential());
+	EXPECT_EQ(Real(0.1), network.getNeurons()[1]->getMembranePotential());
 }
 TEST(NetworkTest, WithSpikes)
 {	/*	We connect two neurons in the network, and see if the spike from neuron1 gets transmitted
 		to neuron2.	*/
 	Neuron neuron1, neuron2;
-	Network network(false, false);
-	network.setNeurons(vector<Neuron*>{new Neuron(neuron1), new Neuron(neuron2)});
+	Network network(false, false, make_shared<NullSink>());
+	network.setNeurons(vector<Neuron>{neuron1, neuron2});
 	network.getNeurons()[0]->setInput(1.01);
 	network.createLink(vector<unsigned int>{0,1});
 	
@@ -103,8 +570,8 @@ TEST(NetworkTest, WithSpikes)
 TEST(NetworkTest, WithSpikes2)
 {	/*This test will see if the delay from the ring buffer is installed correctly.	*/
 	Neuron neuron1, neuron2;
-	Network network(false, false);
-	network.setNeurons(vector<Neuron*>{new Neuron(neuron1), new Neuron(neuron2)});
+	Network network(false, false, make_shared<NullSink>());
+	network.setNeurons(vector<Neuron>{neuron1, neuron2});
 	network.getNeurons()[0]->setInput(1.01);
 	network.createLink(vector<unsigned int>{0,1});
 	
@@ -113,22 +580,736 @@ TEST(NetworkTest, WithSpikes2)
 	/*	The buffer at the time of the spike should be equal to 0, and the one after delay_step should
 	 * 	equal the amplitude transmitted by the neuron that spiked.	*/
 	EXPECT_EQ(0.0, network.getNeurons()[1]->getBuffer(924%(delay_steps+1)));
-	EXPECT_EQ(Amplitude, network.getNeurons()[1]->getBuffer((924+delay_steps)%(delay_steps+1)));
+	EXPECT_EQ(Accumulator(Amplitude), network.getNeurons()[1]->getBuffer((924+delay_steps)%(delay_steps+1)));
+}
+
+TEST(NetworkTest, RefractoryState)
+{	/*	A neuron parked during its refractory period must be found in the same state as if it had 
+	 * 	been updated at every time step.	*/
+	Neuron neuron1;
+	neuron1.setInput(1.01);
+	Network network(false, false, make_shared<NullSink>());
+	network.setNeurons(vector<Neuron>{neuron1});
+	
+	/*	The neuron spikes at 92.4 ms, its refractory period then lasts until 94.4 ms.	*/
+	network.update(93.0);
+	EXPECT_EQ(930u, network.getNeurons()[0]->getPresentTime());
+	EXPECT_EQ(14u, network.getNeurons()[0]->getRefractoryTime());
+	EXPECT_EQ(0.0, network.getNeurons()[0]->getMembranePotential());
+	
+	network.update(94.0);
+	EXPECT_EQ(4u, network.getNeurons()[0]->getRefractoryTime());
+}
+
+TEST(NetworkTest, SpikeDuringRefractoryPeriod)
+{	/*	Both neurons spike at the same time: the spike of the first neuron reaches the second one during
+	 * 	its refractory period and is lost, so both neurons keep spiking at the same times.	*/
+	Neuron neuron1, neuron2;
+	neuron1.setInput(1.01);
+	neuron2.setInput(1.01);
+	Network network(false, false, make_shared<NullSink>());
+	network.setNeurons(vector<Neuron>{neuron1, neuron2});
+	network.createLink(vector<unsigned int>{0,1});
+	network.update(400);
+	
+	EXPECT_EQ(4, network.getNeurons()[1]->getTime().size());
+	EXPECT_EQ(network.getNeurons()[0]->getTime(), network.getNeurons()[1]->getTime());
+}
+
+TEST(StatisticsTest, RegularNeuron)
+{	/*	A neuron with a constant input spikes regularly: 4 spikes in 400 ms, with equal intervals.	*/
+	Neuron neuron1;
+	Network network(false, false, make_shared<NullSink>());
+	network.setNeurons(vector<Neuron>{neuron1});
+	network.getNeurons()[0]->setInput(1.01);
+	SpikeStatistics statistics(1, 1);
+	network.setStatistics(&statistics);
+	network.update(400);
+	
+	EXPECT_EQ(4u, statistics.getSpikes(0));
+	EXPECT_NEAR(10.0, statistics.getMeanRate(true), 1e-9);
+	EXPECT_EQ(0.0, statistics.getMeanRate(false));
+	EXPECT_NEAR(0.0, statistics.getCV(0), 1e-9);
+	EXPECT_EQ(40u, statistics.getBins());
+}
+
+TEST(StatisticsTest, Synchrony)
+{	/*	Two neurons spiking at the same times are fully synchronous.	*/
+	Neuron neuron1;
+	neuron1.setInput(1.01);
+	Network network(false, false, make_shared<NullSink>());
+	network.setNeurons(vector<Neuron>{neuron1, neuron1});
+	SpikeStatistics statistics(2, 1);
+	network.setStatistics(&statistics);
+	network.update(400);
+	
+	EXPECT_NEAR(1.0, statistics.getSynchrony(), 1e-9);
+	EXPECT_NEAR(statistics.getMeanRate(true), statistics.getMeanRate(false), 1e-9);
+	EXPECT_GT(statistics.getMeanFanoFactor(), 0.0);
+}
+
+TEST(ClassifierTest, EarlyTermination)
+{	/*	Two identical regular neurons are synchronous and regular: the simulation stops as soon as their
+	 * 	rate has converged, long before the end time.	*/
+	Neuron neuron1;
+	neuron1.setInput(1.01);
+	Network network(false, false, make_shared<NullSink>());
+	network.setNeurons(vector<Neuron>{neuron1, neuron1});
+	SpikeStatistics statistics(2, 2);
+	RegimeClassifier classifier;
+	network.setStatistics(&statistics);
+	network.setClassifier(&classifier);
+	network.update(2000);
+	
+	EXPECT_TRUE(classifier.isFinished());
+	EXPECT_EQ(SynchronousRegular, classifier.getRegime());
+	EXPECT_GT(20000u, network.getClockTime());
+}
+
+TEST(ClassifierTest, WarmUp)
+{	/*	The neurons all spike together during the first window only, and then in turn: the synchronous
+	 * 	transient is discarded, and the regime is asynchronous.	*/
+	SpikeStatistics statistics(100, 100, 10);
+	RegimeClassifier classifier;
+	unsigned int step(0);
+	for(;step<1000 && !classifier.isFinished();++step)
+	{	for(unsigned int i(0);i<100;++i)
+		{	if(step<100 ? step%50==0 : step%50==i%50)
+			{	statistics.addSpike(i, step);
+			}
+		}
+		if(statistics.endStep())
+		{	classifier.update(statistics);
+		}
+	}
+	EXPECT_EQ(400u, step);
+	EXPECT_EQ(300u, statistics.getSteps());
+	EXPECT_EQ(AsynchronousIrregular, classifier.getRegime());
+	EXPECT_NEAR(0.0, statistics.getSynchrony(), 1e-9);
+}
+
+TEST(ClassifierTest, DeadAndSaturated)
+{	/*	A network without input dies out, a network with a huge input is saturated.	*/
+	Neuron neuron1;
+	Network dead(false, false, make_shared<NullSink>());
+	dead.setNeurons(vector<Neuron>{neuron1});
+	SpikeStatistics dead_statistics(1, 1);
+	RegimeClassifier dead_classifier;
+	dead.setStatistics(&dead_statistics);
+	dead.setClassifier(&dead_classifier);
+	dead.update(2000);
+	EXPECT_EQ(Quiescent, dead_classifier.getRegime());
+	EXPECT_GT(20000u, dead.getClockTime());
+	
+	neuron1.setInput(1000.0);
+	Network saturated(false, false, make_shared<NullSink>());
+	saturated.setNeurons(vector<Neuron>{neuron1});
+	SpikeStatistics saturated_statistics(1, 1);
+	RegimeClassifier saturated_classifier;
+	saturated.setStatistics(&saturated_statistics);
+	saturated.setClassifier(&saturated_classifier);
+	saturated.update(2000);
+	EXPECT_EQ(Saturated, saturated_classifier.getRegime());
+}
+
+TEST(SpectrumTest, DominantFrequency)
+{	/*	A population activity oscillating at 50 Hz (a period of 200 time steps) gives a peak at 50 Hz,
+	 * 	within the resolution of the spectrum.	*/
+	SpectralEstimator spectrum;
+	EXPECT_EQ(0.0, spectrum.getDominantFrequency());
+	for(unsigned int step(0);step<20000;++step)
+	{	spectrum.addStep(step%200<20 ? 10 : 1);
+	}
+	
+	EXPECT_LT(0u, spectrum.getSegments());
+	EXPECT_NEAR(50.0, spectrum.getDominantFrequency(), spectrum.getFrequency(1));
+}
+
+TEST(SpectrumTest, Network)
+{	/*	The spectrum of a network is estimated during the simulation: 2000 ms give 4000 bins of 0.5 ms, 
+	 * 	so 14 windows of 512 bins overlapping by half.	*/
+	Neuron neuron1;
+	neuron1.setInput(1.01);
+	Network network(false, false, make_shared<NullSink>());
+	network.setNeurons(vector<Neuron>{neuron1, neuron1});
+	SpectralEstimator spectrum;
+	network.setSpectralEstimator(&spectrum);
+	network.update(2000);
+	
+	EXPECT_EQ(14u, spectrum.getSegments());
+	EXPECT_LT(0.0, spectrum.getDominantFrequency());
+}
+
+TEST(MeanFieldTest, Brunel)
+{	/*	Without noise, the Siegert formula gives the rate of a neuron with a constant input.	*/
+	EXPECT_NEAR(1000.0/(RefractoryPeriod*dt+Tao*log(30.0/10.0)), 1000.0*MeanField::siegert(30.0, 0.3), 0.5);
+	
+	/*	The production network is asynchronous irregular, at about the rate it is simulated at.	*/
+	MeanField production;
+	EXPECT_EQ(AsynchronousIrregular, production.getRegime());
+	EXPECT_NEAR(32.0, production.getRate(), 1.0);
+	EXPECT_EQ(size_t(ceil(TotalNeurons*production.getRate()/10.0)), production.getExpectedSpikes(TotalNeurons, 100.0));
+	
+	/*	The stationary distribution of the non-refractory neurons.	*/
+	double total(0.0);
+	for(double potential(-50.0);potential<MembraneThreshold;potential+=0.01)
+	{	total+=production.getDensity(potential)*0.01;
+	}
+	EXPECT_NEAR(1.0-production.getRate()/1000.0*RefractoryPeriod*dt, total, 1e-3);
+	
+	/*	The other regimes of the paper.	*/
+	EXPECT_EQ(SynchronousRegular, MeanField(3.0, 2.0).getRegime());
+	EXPECT_EQ(SynchronousIrregularFast, MeanField(6.0, 4.0).getRegime());
+	EXPECT_EQ(SynchronousIrregularSlow, MeanField(4.5, 0.9).getRegime());
+	EXPECT_EQ(Quiescent, MeanField(5.0, 0.0).getRegime());
+	EXPECT_TRUE(production.isResolved());
+	EXPECT_FALSE(MeanField(4.2, 2.0).isResolved());
+}
+
+TEST(ProcessEngineTest, SameSpikeTrains)
+{	/*	Two identical networks of neurons receiving different inputs, linked in a ring and to their
+	 * 	second neighbour.	*/
+	vector<Neuron> neurons(12);
+	for(size_t i(0);i<neurons.size();++i)
+	{	neurons[i].setInput(i%3==0 ? 0.0 : 0.98+0.01*i);
+	}
+	Network single(false, false, make_shared<NullSink>()), shared(false, false, make_shared<NullSink>());
+	single.setNeurons(neurons);
+	shared.setNeurons(neurons);
+	for(unsigned int i(0);i<neurons.size();++i)
+	{	single.createLink({i, (i+1)%12});
+		single.createLink({i, (i+2)%12});
+		shared.createLink({i, (i+1)%12});
+		shared.createLink({i, (i+2)%12});
+	}
+	
+	/*	The simulation is split in two to check that the workers start from the state of the network.	*/
+	single.update(100);
+	ProcessEngine engine(shared, 3);
+	engine.update(41);
+	engine.update(100);
+	
+	EXPECT_EQ(single.getClockTime(), shared.getClockTime());
+	size_t spikes(0);
+	for(size_t i(0);i<neurons.size();++i)
+	{	spikes+=single.getNeurons()[i]->getTime().getTotal();
+		EXPECT_TRUE(single.getNeurons()[i]->getTime()==shared.getNeurons()[i]->getTime());
+		EXPECT_EQ(single.getNeurons()[i]->getMembranePotential(), shared.getNeurons()[i]->getMembranePotential());
+		EXPECT_EQ(single.getNeurons()[i]->getRefractoryTime(), shared.getNeurons()[i]->getRefractoryTime());
+		for(unsigned int k(0);k<=delay_steps;++k)
+		{	EXPECT_EQ(single.getNeurons()[i]->getBuffer(k), shared.getNeurons()[i]->getBuffer(k));
+		}
+	}
+}
+
+TEST(ProcessEngineTest, SameRandomSpikes)
+{	/*	The random spikes of a neuron at a time step do not depend on the process drawing them.	*/
+	Network single(false, true, make_shared<NullSink>()), shared(false, true, make_shared<NullSink>());
+	single.setNeurons(vector<Neuron>(12));
+	shared.setNeurons(vector<Neuron>(12));
+	single.setSeed(11);
+	shared.setSeed(11);
+	for(unsigned int i(0);i<12;++i)
+	{	single.createLink({i, (i+5)%12});
+		shared.createLink({i, (i+5)%12});
+	}
+	
+	single.update(200);
+	ProcessEngine engine(shared, 4);
+	engine.update(200);
+	
+	SpikeComparison comparison;
+	comparison.compare(SpikeComparison::collect(single), SpikeComparison::collect(shared));
+	EXPECT_GT(comparison.getReferenceSpikes(), 0u);
+	EXPECT_EQ(12u, comparison.getIdenticalNeurons());
+}
+
+TEST(ProcessEngineTest, ExternalPopulation)
+{	/*	The workers deliver the spikes of their copies of the population to their own neurons.	*/
+	Network single(false, false, make_shared<NullSink>()), shared(false, false, make_shared<NullSink>());
+	single.setNeurons(vector<Neuron>(12));
+	shared.setNeurons(vector<Neuron>(12));
+	for(unsigned int i(0);i<12;++i)
+	{	single.createLink({i, (i+5)%12});
+		shared.createLink({i, (i+5)%12});
+	}
+	ExternalPopulation single_population(12, 400, 3), shared_population(12, 400, 3);
+	single.setSpikeSource(&single_population);
+	shared.setSpikeSource(&shared_population);
+	
+	single.update(200);
+	ProcessEngine engine(shared, 4);
+	engine.update(100);
+	engine.update(200);
+	
+	SpikeComparison comparison;
+	comparison.compare(SpikeComparison::collect(single), SpikeComparison::collect(shared));
+	EXPECT_GT(comparison.getReferenceSpikes(), 0u);
+	EXPECT_EQ(12u, comparison.getIdenticalNeurons());
+	EXPECT_EQ(single_population.getTotalSpikes(), shared_population.getTotalSpikes());
+}
+
+TEST(ProcessEngineTest, Stimuli)
+{	/*	The workers apply the stimuli to their own neurons.	*/
+	Network single(false, false, make_shared<NullSink>()), shared(false, false, make_shared<NullSink>());
+	single.setNeurons(vector<Neuron>(12));
+	shared.setNeurons(vector<Neuron>(12));
+	for(unsigned int i(0);i<12;++i)
+	{	single.createLink({i, (i+5)%12});
+		shared.createLink({i, (i+5)%12});
+	}
+	StimulusSchedule schedule;
+	schedule.addSine(schedule.addGroup(0, 12), 10.0, 150.0, 1.0, 0.5, 40.0);
+	schedule.addNoise(schedule.addGroup({2, 7, 9}), 50.0, 120.0, 0.5, 0.5, 8);
+	schedule.addSteps(schedule.addGroup({7}), {{250.0, 0.3}});
+	StimulusSchedule copy(schedule);
+	single.setStimuli(&schedule);
+	single.update(200);
+	shared.setStimuli(&copy);
+	ProcessEngine engine(shared, 4);
+	engine.update(200);
+	
+	SpikeComparison comparison;
+	comparison.compare(SpikeComparison::collect(single), SpikeComparison::collect(shared));
+	EXPECT_GT(comparison.getReferenceSpikes(), 0u);
+	EXPECT_EQ(12u, comparison.getIdenticalNeurons());
+	for(size_t i(0);i<12;++i)
+	{	EXPECT_EQ(single.getNeurons()[i]->getInput(), shared.getNeurons()[i]->getInput());
+	}
+	
+	/*	An input set between two simulations is kept, and the next changes of the stimuli are added to it.	*/
+	single.getNeurons()[7]->setInput(1.5);
+	shared.getNeurons()[7]->setInput(1.5);
+	single.update(300);
+	engine.update(300);
+	comparison.compare(SpikeComparison::collect(single), SpikeComparison::collect(shared));
+	EXPECT_EQ(12u, comparison.getIdenticalNeurons());
+	EXPECT_EQ(Real(1.8), shared.getNeurons()[7]->getInput());
+	for(size_t i(0);i<12;++i)
+	{	EXPECT_EQ(single.getNeurons()[i]->getInput(), shared.getNeurons()[i]->getInput());
+	}
+}
+
+/*	Source whose copies in the worker processes are killed, or throw, at a time step.	*/
+class FailingSource : public SpikeSource
+{	private:
+	pid_t network_;
+	unsigned int step_;
+	bool killed_;
+	
+	public:
+	FailingSource(unsigned int step, bool killed)
+		:	SpikeSource(Projection(1), 0.0), network_(getpid()), step_(step), killed_(killed) {}
+	void reset(unsigned int const&) override {}
+	View<unsigned int const> fire(unsigned int const& time) override
+	{	if(time==step_ && getpid()!=network_)
+		{	if(killed_)
+			{	raise(SIGKILL);
+			}
+			throw runtime_error("FailingSource");
+		}
+		return View<unsigned int const>();
+	}
+};
+
+TEST(ProcessEngineTest, DeadWorker)
+{	/*	A worker which is killed or throws stops the simulation, instead of leaving the network waiting.	*/
+	for(int killed(0);killed<2;++killed)
+	{	Network network(false, false, make_shared<NullSink>());
+		network.setNeurons(vector<Neuron>(12));
+		for(unsigned int i(0);i<12;++i)
+		{	network.createLink({i, (i+5)%12});
+		}
+		FailingSource source(500, killed);
+		network.setSpikeSource(&source);
+		ProcessEngine engine(network, 3);
+		EXPECT_THROW(engine.update(100), runtime_error);
+	}
+}
+
+TEST(ProcessEngineTest, Placement)
+{	/*	The kernel lists the CPUs of a node as ranges.	*/
+	EXPECT_EQ(vector<unsigned int>({0, 1, 2, 3, 8, 10, 11}), Topology::parseList("0-3,8,10-11\n"));
+	
+	/*	On a machine with two nodes of two CPUs, consecutive workers share a node.	*/
+	Network network(false, false, make_shared<NullSink>());
+	network.setNeurons(vector<Neuron>(10));
+	ProcessEngine engine(network, 4, Topology({{0, 1}, {2, 3}}));
+	EXPECT_EQ(0u, engine.getNode(1));
+	EXPECT_EQ(1u, engine.getNode(2));
+	EXPECT_EQ(3u, engine.getCpu(3));
+	EXPECT_EQ(5u, engine.getPartition(2));
+	
+	ostringstream report;
+	engine.report(report);
+	EXPECT_NE(string::npos, report.str().find("worker 2: node 1, cpu 2, neurons 5 to 7"));
+}
+
+TEST(SchedulerTest, AllTasksOnce)
+{	/*	Each task is executed exactly once, whatever the thread executing it.	*/
+	TaskScheduler scheduler(4);
+	EXPECT_EQ(4u, scheduler.getThreads());
+	vector<atomic<unsigned int>> executed(1000);
+	for(int run(0);run<3;++run)
+	{	scheduler.run(executed.size(), [&](size_t task)
+		{	/*	The first tasks are long, so that the other threads steal them.	*/
+			if(task<10)
+			{	this_thread::sleep_for(chrono::milliseconds(1));
+			}
+			++executed[task];
+		});
+	}
+	for(size_t i(0);i<executed.size();++i)
+	{	EXPECT_EQ(3u, executed[i]);
+	}
+}
+
+TEST(SchedulerTest, SameSpikeTrains)
+{	/*	Two identical networks, one of them simulated with threads.	*/
+	vector<Neuron> neurons(600);
+	for(size_t i(0);i<neurons.size();++i)
+	{	neurons[i].setInput(i%3==0 ? 0.0 : 0.98+0.0001*i);
+	}
+	Network single(false, false, make_shared<NullSink>()), threaded(false, false, make_shared<NullSink>());
+	single.setNeurons(neurons);
+	threaded.setNeurons(neurons);
+	for(unsigned int i(0);i<neurons.size();++i)
+	{	for(unsigned int j(1);j<=3;++j)
+		{	single.createLink({i, (i+7*j)%600});
+			threaded.createLink({i, (i+7*j)%600});
+		}
+	}
+	TaskScheduler scheduler(3);
+	threaded.setScheduler(&scheduler);
+	single.update(100);
+	threaded.update(100);
+	
+	size_t spikes(0);
+	for(size_t i(0);i<neurons.size();++i)
+	{	spikes+=single.getNeurons()[i]->getTime().getTotal();
+		EXPECT_TRUE(single.getNeurons()[i]->getTime()==threaded.getNeurons()[i]->getTime());
+		EXPECT_EQ(single.getNeurons()[i]->getMembranePotential(), threaded.getNeurons()[i]->getMembranePotential());
+	}
+	EXPECT_GT(spikes, 0u);
+}
+
+TEST(PrecisionTest, Comparison)
+{	/*	The second neuron has a spike moved by one time step, and the third one has lost a spike.	*/
+	SpikeTrains reference{{10, 50, 90}, {20, 40, 60}, {30, 70}};
+	SpikeTrains test{{10, 50, 90}, {20, 41, 60}, {30}};
+	
+	SpikeComparison exact;
+	exact.compare(reference, test);
+	EXPECT_EQ(8u, exact.getReferenceSpikes());
+	EXPECT_EQ(7u, exact.getTestSpikes());
+	EXPECT_EQ(6u, exact.getCoincidences());
+	EXPECT_EQ(1u, exact.getIdenticalNeurons());
+	EXPECT_EQ(40u, exact.getFirstDivergence());
+	EXPECT_DOUBLE_EQ(-1.0/8, exact.getRateError());
+	
+	/*	Within one time step, only the lost spike does not coincide.	*/
+	SpikeComparison window(1);
+	window.compare(reference, test);
+	EXPECT_EQ(7u, window.getCoincidences());
+	EXPECT_DOUBLE_EQ(14.0/15, window.getCoincidenceFactor());
+	
+	/*	Identical trains are found identical.	*/
+	window.compare(reference, reference);
+	EXPECT_EQ(1.0, window.getCoincidenceFactor());
+	EXPECT_EQ(numeric_limits<unsigned int>::max(), window.getFirstDivergence());
+	EXPECT_EQ(0.0, window.getCVError());
 }
 
 TEST(AllNeuronsTest, NumberNeurons)
 {	/*	A test verifying that there are 12500 neurons in the network.	*/
-	Network network(true, true);
+	Network network(true, true, make_shared<NullSink>());
 	EXPECT_EQ(TotalNeurons, network.getNeurons().size());
 }
 
 TEST(AllNeuronsTest, NumberConnections)
 {	/*	This test verifies that each neuron has exactly 1250 connections.	*/
-	Network network(true, true);
+	Network network(true, true, make_shared<NullSink>());
 	EXPECT_EQ(TotalConnections, network.getLinks()[0].size());
 	
 }
 
+TEST(AllNeuronsTest, Views)
+{	/*	The views give the same values as the containers, without copying them.	*/
+	Network network(true, false, make_shared<NullSink>());
+	View<unsigned int const> row(network.getLinkRow(3));
+	ASSERT_EQ(TotalConnections, row.size());
+	EXPECT_EQ(network.getLinks()[3].data(), row.data());
+	for(size_t j(0);j<row.size();++j)
+	{	EXPECT_EQ(network.getLinks()[3][j], row[j]);
+	}
+	
+	network.getNeurons()[5]->setMembranePotential(12.0);
+	PotentialView potentials(network.getPotentials());
+	EXPECT_EQ(TotalNeurons, potentials.size());
+	EXPECT_EQ(12.0, potentials[5]);
+	double total(0.0);
+	for(double potential: potentials)
+	{	total+=potential;
+	}
+	EXPECT_EQ(12.0, total);
+}
+
+TEST(AllNeuronsTest, Arena)
+{	/*	The neurons of the network are constructed next to each other in its arena.	*/
+	Network network(true, false, make_shared<NullSink>());
+	EXPECT_EQ(network.getNeurons()[0]+1, network.getNeurons()[1]);
+	EXPECT_EQ(network.getNeurons()[0]+TotalNeurons-1, network.getNeurons()[TotalNeurons-1]);
+	
+	/*	Replacing the neurons destroys the previous ones and their links.	*/
+	Neuron neuron1;
+	neuron1.setInput(1.01);
+	network.setNeurons(vector<Neuron>{neuron1, neuron1});
+	EXPECT_EQ(2u, network.getNeurons().size());
+	EXPECT_EQ(0u, network.getLinks().size());
+	EXPECT_EQ(Real(1.01), network.getNeurons()[1]->getInput());
+}
+
+TEST(AllNeuronsTest, HugePages)
+{	/*	Large arrays are aligned on huge pages, and small ones or all of them when disabled use normal pages.	*/
+	HugePageAllocator pages;
+	size_t bytes(3<<20);
+	PageKind kind;
+	char* data(static_cast<char*>(pages.allocate(bytes, kind)));
+	EXPECT_EQ(4u<<20, bytes);
+	EXPECT_EQ(0u, reinterpret_cast<size_t>(data)%HugePageAllocator::HugePageSize);
+	EXPECT_EQ(bytes, pages.getBytes(kind));
+	data[0]=data[bytes-1]=1;
+	pages.deallocate(data, bytes, kind);
+	EXPECT_EQ(0u, pages.getBytes(kind));
+	
+	pages.setEnabled(false);
+	bytes=3<<20;
+	data=static_cast<char*>(pages.allocate(bytes, kind));
+	EXPECT_EQ(NormalPages, kind);
+	pages.deallocate(data, bytes, kind);
+	
+	/*	A mapping which cannot be made throws, instead of returning an invalid address.	*/
+	bytes=size_t(1)<<62;
+	EXPECT_THROW(pages.allocate(bytes, kind), bad_alloc);
+	
+	/*	A network built neuron by neuron only maps a small block of normal pages.	*/
+	Network small(false, false, make_shared<NullSink>());
+	small.setNeurons(vector<Neuron>(2));
+	EXPECT_EQ(1u, small.getArena().getBlocks());
+	EXPECT_EQ(Network::SmallBlock, small.getArena().getPages().getBytes(NormalPages));
+	EXPECT_EQ(0u, small.getArena().getPages().getBytes(TransparentHugePages)+small.getArena().getPages().getBytes(HugeTLBPages));
+	
+	/*	The links of the network are in a block of their own, backed by huge pages if the system allows it.	*/
+	Network network(true, false, make_shared<NullSink>());
+	Arena const& arena(network.getConnectivity()->getArena());
+	HugePageAllocator const& mapped(arena.getPages());
+	size_t total(mapped.getBytes(NormalPages)+mapped.getBytes(TransparentHugePages)+mapped.getBytes(HugeTLBPages));
+	EXPECT_GE(total, TotalNeurons*TotalConnections*sizeof(unsigned int));
+	EXPECT_LE(arena.getResidentHugeBytes(), total);
+}
+
+TEST(AllNeuronsTest, SpecializedEngine)
+{	/*	With the same seed, the specialized engine has the links and the spikes of the generic network.	*/
+	DefaultBrunelEngine engine(7);
+	Network network(true, true, make_shared<NullSink>());
+	network.setSeed(7);
+	EXPECT_EQ(16u, DefaultBrunelEngine::Slots);
+	for(unsigned int j(0);j<TotalConnections;++j)
+	{	EXPECT_EQ(network.getLinkRow(42)[j], engine.getLinkRow(42)[j]);
+	}
+	
+	engine.update(30);
+	network.update(30);
+	EXPECT_EQ(network.getClockTime(), engine.getClockTime());
+	EXPECT_GT(engine.getTotalSpikes(), 0u);
+	
+	SpikeComparison comparison;
+	comparison.compare(SpikeComparison::collect(network), engine.getTrains());
+	EXPECT_EQ(TotalNeurons, comparison.getIdenticalNeurons());
+	for(unsigned int i(0);i<TotalNeurons;i+=101)
+	{	EXPECT_EQ(network.getNeurons()[i]->getMembranePotential(), engine.getMembranePotential(i));
+	}
+}
+
+TEST(AllNeuronsTest, Delays)
+{	/*	The links of each neuron are sorted by delay, and the buffers are deep enough for the longest one.	*/
+	Network single(true, false, make_shared<NullSink>()), shared(true, false, make_shared<NullSink>());
+	single.setSeed(5);
+	shared.setSeed(5);
+	single.setDelays(4, 30);
+	shared.setDelays(2, 40);
+	shared.setDelays(4, 30);
+	EXPECT_EQ(32u, single.getNeurons()[0]->getBufferDepth());
+	
+	/*	The delays drawn again do not depend on the previous ones, and reuse their memory.	*/
+	size_t allocated(shared.getConnectivity()->getArena().getAllocated());
+	shared.setDelays(4, 30);
+	EXPECT_EQ(allocated, shared.getConnectivity()->getArena().getAllocated());
+	for(unsigned int i(0);i<TotalNeurons;i+=1000)
+	{	for(unsigned int j(0);j<TotalConnections;++j)
+		{	ASSERT_EQ(single.getLinkRow(i)[j], shared.getLinkRow(i)[j]);
+		}
+	}
+	
+	size_t total(0);
+	for(unsigned int delay(4);delay<=30;++delay)
+	{	View<unsigned int const> targets(single.getTargets(42, delay));
+		EXPECT_EQ(single.getLinkRow(42).begin()+total, targets.begin());
+		total+=targets.size();
+	}
+	EXPECT_EQ(TotalConnections, total);
+	EXPECT_EQ(0u, single.getTargets(42, 3).size());
+	
+	/*	A few neurons with an input drive the others, and the workers simulate intervals of the shortest delay.	*/
+	for(unsigned int i(0);i<TotalNeurons;i+=50)
+	{	single.getNeurons()[i]->setInput(1.5+0.01*(i%7));
+		shared.getNeurons()[i]->setInput(1.5+0.01*(i%7));
+	}
+	single.update(60);
+	ProcessEngine engine(shared, 3);
+	engine.update(60);
+	
+	SpikeComparison comparison;
+	comparison.compare(SpikeComparison::collect(single), SpikeComparison::collect(shared));
+	EXPECT_GT(comparison.getReferenceSpikes(), TotalNeurons/50);
+	EXPECT_EQ(TotalNeurons, comparison.getIdenticalNeurons());
+}
+
+TEST(AllNeuronsTest, Trials)
+{	/*	The trial with the seed of the network has its spike trains, and a trial does not depend on the others,
+	 * 	whether it is updated in a block of TrialEngine::Lanes trials or alone.	*/
+	Network network(true, true, make_shared<NullSink>());
+	network.setSeed(9);
+	TrialEngine batch(network, {9, 10, 11, 12, 13, 14, 15, 16, 17});
+	TrialEngine alone(network, {12});
+	network.update(20);
+	batch.update(20);
+	alone.update(20);
+	
+	SpikeComparison comparison;
+	comparison.compare(SpikeComparison::collect(network), batch.getTrains(0));
+	EXPECT_GT(comparison.getReferenceSpikes(), 0u);
+	EXPECT_EQ(TotalNeurons, comparison.getIdenticalNeurons());
+	EXPECT_EQ(network.getNeurons()[77]->getMembranePotential(), batch.getMembranePotential(0, 77));
+	
+	comparison.compare(alone.getTrains(0), batch.getTrains(3));
+	EXPECT_EQ(TotalNeurons, comparison.getIdenticalNeurons());
+	comparison.compare(batch.getTrains(0), batch.getTrains(1));
+	EXPECT_LT(comparison.getIdenticalNeurons(), TotalNeurons);
+	
+	/*	The links of a neuron are read once per time step for all the trials in which it spiked.	*/
+	size_t spikes(0);
+	for(size_t t(0);t<batch.getTrials();++t)
+	{	spikes+=batch.getTotalSpikes(t);
+	}
+	EXPECT_LT(batch.getRowsRead(), spikes);
+}
+
+TEST(AllNeuronsTest, Fork)
+{	/*	A child continues the simulation of its parent, sharing its connectivity until it modifies it.	*/
+	Network parent(true, true, make_shared<NullSink>());
+	parent.setSeed(4);
+	parent.update(10);
+	
+	Network same(parent, 4), other(parent, 5);
+	EXPECT_EQ(parent.getConnectivity(), same.getConnectivity());
+	EXPECT_EQ(parent.getClockTime(), other.getClockTime());
+	EXPECT_EQ(parent.getNeurons()[3]->getMembranePotential(), other.getNeurons()[3]->getMembranePotential());
+	EXPECT_NE(parent.getNeurons()[3], other.getNeurons()[3]);
+	
+	parent.update(20);
+	same.update(20);
+	other.update(20);
+	SpikeComparison comparison;
+	comparison.compare(SpikeComparison::collect(parent), SpikeComparison::collect(same));
+	EXPECT_EQ(TotalNeurons, comparison.getIdenticalNeurons());
+	comparison.compare(SpikeComparison::collect(parent), SpikeComparison::collect(other));
+	EXPECT_LT(comparison.getIdenticalNeurons(), TotalNeurons);
+	
+	/*	Drawing delays copies the connectivity of the child only.	*/
+	View<unsigned int const> row(parent.getLinkRow(8));
+	vector<unsigned int> links(row.begin(), row.end());
+	other.setDelays(10, 20);
+	EXPECT_NE(parent.getConnectivity(), other.getConnectivity());
+	EXPECT_EQ(delay_steps, parent.getMaxDelay());
+	EXPECT_TRUE(equal(links.begin(), links.end(), parent.getLinkRow(8).begin()));
+}
+
+TEST(AllNeuronsTest, InitialPotentials)
+{	/*	Uniform potentials lie between the reset potential and the threshold.	*/
+	Network uniform(true, true, make_shared<NullSink>(), 0, UniformPotentials);
+	double sum(0.0), low(MembraneThreshold), high(MembraneReset);
+	for(size_t i(0);i<TotalNeurons;++i)
+	{	double potential(uniform.getNeurons()[i]->getMembranePotential());
+		sum+=potential;
+		low=min(low, potential);
+		high=max(high, potential);
+	}
+	EXPECT_LE(MembraneReset, low);
+	EXPECT_GT(MembraneThreshold, high);
+	EXPECT_NEAR(0.5*(MembraneReset+MembraneThreshold), sum/TotalNeurons, 0.2);
+	
+	/*	Stationary potentials have the refractory fraction and the mean of the predicted distribution.	*/
+	Network stationary(true, true, make_shared<NullSink>(), 0, StationaryPotentials);
+	stationary.setSeed(6);
+	MeanField mean_field;
+	vector<double> quantiles(mean_field.getQuantiles(1000));
+	double refractory(mean_field.getRate()/1000.0*RefractoryPeriod*dt), expected(0.0);
+	for(size_t k(0);k<quantiles.size();++k)
+	{	expected+=quantiles[k]/quantiles.size();
+	}
+	size_t refractory_neurons(0);
+	sum=0.0;
+	for(size_t i(0);i<TotalNeurons;++i)
+	{	Neuron const* neuron(stationary.getNeurons()[i]);
+		if(neuron->getRefractoryTime()>0)
+		{	++refractory_neurons;
+			EXPECT_EQ(MembraneReset, neuron->getMembranePotential());
+		} else {
+			sum+=neuron->getMembranePotential();
+			EXPECT_GT(MembraneThreshold, neuron->getMembranePotential());
+		}
+	}
+	EXPECT_NEAR(refractory, double(refractory_neurons)/TotalNeurons, 0.01);
+	EXPECT_NEAR(expected, sum/(TotalNeurons-refractory_neurons), 0.2);
+	
+	/*	Neurons starting from the stationary state do not go through the synchronous burst of neurons at rest.	*/
+	Network rest(true, true, make_shared<NullSink>());
+	rest.setSeed(6);
+	rest.update(20);
+	stationary.update(20);
+	vector<size_t> rest_spikes(200, 0), stationary_spikes(200, 0);
+	SpikeTrains rest_trains(SpikeComparison::collect(rest)), stationary_trains(SpikeComparison::collect(stationary));
+	for(size_t i(0);i<TotalNeurons;++i)
+	{	for(size_t k(0);k<rest_trains[i].size();++k)
+		{	++rest_spikes[rest_trains[i][k]];
+		}
+		for(size_t k(0);k<stationary_trains[i].size();++k)
+		{	++stationary_spikes[stationary_trains[i][k]];
+		}
+	}
+	EXPECT_LT(2*(*max_element(stationary_spikes.begin(), stationary_spikes.end())), *max_element(rest_spikes.begin(), rest_spikes.end()));
+}
+
+TEST(AllNeuronsTest, DiffusionInput)
+{	/*	The network has the same rate with random spikes and with their diffusion approximation.	*/
+	vector<size_t> totals;
+	for(unsigned int input(PoissonInput);input<=OrnsteinUhlenbeckInput;++input)
+	{	Network network(true, true, make_shared<NullSink>(), 0, StationaryPotentials);
+		network.setSeed(9);
+		network.setExternalInput(ExternalInput(input), 0.1);
+		network.update(40);
+		SpikeTrains trains(SpikeComparison::collect(network));
+		size_t total(0);
+		for(size_t i(0);i<TotalNeurons;++i)
+		{	total+=trains[i].size();
+		}
+		totals.push_back(total);
+	}
+	EXPECT_NEAR(1.0, double(totals[GaussianInput])/totals[PoissonInput], 0.1);
+	EXPECT_NEAR(1.0, double(totals[OrnsteinUhlenbeckInput])/totals[PoissonInput], 0.1);
+}
+
 int main(int argc, char **argv) 
 {
 		::testing::InitGoogleTest(&argc, argv);
@@ -20,7 +20,7 @@ int main()
 	Neuron neuron1; /*	Initialization of a neuron.	*/
 	neuron1.setInput(input);
 	Network network(false, false);
-	network.setNeurons(vector<Neuron*>{new Neuron(neuron1)});
+	network.setNeurons(vector<Neuron>{neuron1});
     network.update(time); /*	Update of the membrane potential.	*/
 	network.getNeurons()[0]->showTimeValues();	/*	Shows the spike time values to show the evolution of the membrane potential.	*/
 
@@ -0,0 +1,28 @@
+#include "SpikeComparison.hpp"
+#include <iostream>
+#include <cstdlib>
+
+using namespace std;
+
+int main(int argc, char** argv)
+{	
+	/*	Usage: SpikeTrains file [time] [seed]. The spike trains of all 12500 neurons with background noise
+	 * 	are written in the file, to be compared with the ones of another precision by CompareSpikes.	*/
+	if(argc<2)
+	{	cerr<<"Usage: "<<argv[0]<<" file [time] [seed]"<<endl;
+		return 1;
+	}
+	double time(argc>2 ? atof(argv[2]) : 200.0);
+	unsigned int seed(argc>3 ? atoi(argv[3]) : 1);
+
+	/*	The seed fixes the links and the random spikes, so that the simulations in the different precisions
+	 * 	only differ by their rounding. The spikes are collected from the neurons, so they are not written
+	 * 	by the network.	*/
+	Network network(true, true, make_shared<NullSink>());
+	network.setSeed(seed);
+	network.update(time);
+
+	SpikeComparison::write(SpikeComparison::collect(network), argv[1]);
+	cout<<PrecisionName<<" precision: "<<network.getClockTime()*dt<<" ms simulated with seed "<<seed<<endl;
+	return 0;
+}
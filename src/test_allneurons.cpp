@@ -14,11 +14,29 @@ int main()
 	} while(time<0.0);
 
 	/*	In this test, we want to test all 12500 neurons (first argument=true) with background noise
-	 * 	(second argument=true).	*/
-	Network network(true, true);
+	 * 	(second argument=true). Only the statistics are printed, so the spikes are not written.	*/
+	Network network(true, true, make_shared<NullSink>());
+	
+	/*	The regime of the network is classified during the simulation, which stops once it is known.	*/
+	SpikeStatistics statistics(TotalNeurons, NumberExcitatoryNeurons);
+	RegimeClassifier classifier;
+	SpectralEstimator spectrum;
+	network.setStatistics(&statistics);
+	network.setClassifier(&classifier);
+	network.setSpectralEstimator(&spectrum);
 	
 	/*	We update the network with the wanted simulation time.	*/
 	network.update(time);
+	
+	cout<<"Simulated time: "<<network.getClockTime()*dt<<" ms"<<endl;
+	cout<<"Mean rates: "<<statistics.getMeanRate(true)<<" Hz (excitatory), "
+		<<statistics.getMeanRate(false)<<" Hz (inhibitory)"<<endl;
+	cout<<"Mean CV: "<<statistics.getMeanCV()<<", synchrony: "<<statistics.getSynchrony()<<endl;
+	cout<<"Dominant frequency: "<<spectrum.getDominantFrequency()<<" Hz"<<endl;
+	cout<<"Regime: "<<RegimeClassifier::getName(classifier.getRegime())<<endl;
+	cout<<"Memory of the network:"<<endl;
+	network.getArena().getPages().report(cout);
+	cout<<"resident in huge pages: "<<network.getArena().getResidentHugeBytes()/1024<<" kB"<<endl;
 
 	return 0;
 }